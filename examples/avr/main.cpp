@@ -19,7 +19,11 @@ ButtonPin button2( & PIN(BUTTON_2), portBIT(BUTTON_2) );
 
 void myISR( void* )
 {
-    button1.tick( IS_TRUE(BUTTON_1) );
+    // AvrTimers calls this task via a function pointer, so the ISR saves all
+    // call-clobbered registers anyway; tickInline() only saves the call to tick()
+    // and the virtual pressed(). For the full benefit, call it from your own
+    // ISR(), see README.
+    button1.tickInline( IS_TRUE(BUTTON_1) );
 }
 
 
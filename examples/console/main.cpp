@@ -0,0 +1,81 @@
+/**
+ * @file 		  main.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Target program for the `ButtonConsole` check, run by `sim.cpp` in simavr.
+ *
+ * Two buttons on PB0 and PB1, active high, ticked every 10 ms by the Timer0 compare
+ * ISR via `Button::isr()`, which is timed with `console.budget`. The main loop only
+ * calls `console.poll()`. Built with BUTTON_CONSOLE, BUTTON_RUNTIME_THRESHOLDS and
+ * BUTTON_BOUNCE_STATS, so all commands and fields are there, and with a transmit buffer
+ * of 128 bytes, enough for the reply to `s`.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr_mcu_section.h>
+
+#include <Button.h>
+#include <ButtonConsole.h>
+
+AVR_MCU( F_CPU, "atmega328p" );
+
+#define NBUTTONS	2
+
+//----------------------------------------------------------------------------
+
+/// Button on a pin of port B, high when pressed
+class PinButton : public Button {
+	public:
+		uint8_t	mask;
+		virtual bool pressed() { return (PINB & mask) != 0; }
+};
+
+PinButton buttons[NBUTTONS];
+ButtonConsole console;
+
+//----------------------------------------------------------------------------
+
+ISR(TIMER0_COMPA_vect)
+{
+	console.budget.begin();
+	for (uint8_t i=0; i<NBUTTONS; i++)
+		Button::isr( &buttons[i] );
+	console.budget.end();
+}
+
+
+int main()
+{
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);							// free running, at F_CPU, for the budget
+	TCCR0A = _BV(WGM01);						// CTC
+	TCCR0B = _BV(CS02) | _BV(CS00);				// F_CPU/1024
+	OCR0A = F_CPU / 1024 * Button::MS_PER_TICK / 1000 - 1;
+	TIMSK0 = _BV(OCIE0A);
+
+	console.begin( 38400 );
+	for (uint8_t i=0; i<NBUTTONS; i++) {
+		buttons[i].mask = _BV(i);
+		console.add( &buttons[i] );
+	}
+	sei();
+
+	for (;;)
+		console.poll();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file 		  sim.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Check `ButtonConsole` on a simulated ATmega328P, using libsimavr.
+ *
+ * Loads the target program (`main.cpp`), drives its button pins through presses,
+ * long presses and a double click, sends commands to USART0 and compares the replies:
+ * - `s` before and after the presses, with the counters and raw edge counts
+ * - `l` and `d` with and without argument, incl. the clamp to 60000 ms, and a press
+ *   that is short with the new long press threshold
+ * - `c`, which must report a plausible ISR duration
+ * - `z`, then `s` with all counters cleared
+ * - an unknown command, an empty line, and a line longer than the receive buffer
+ *
+ * usage: sim <elf file>
+ * Exit code is 1 if any check failed, 2 if the program could not be run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include <sim_avr.h>
+#include <sim_elf.h>
+#include <avr_uart.h>
+#include <avr_ioport.h>
+
+static avr_t* avr;
+static avr_irq_t* uartIn;
+static std::string tx;				// characters sent by the target since the last command
+static unsigned bad;
+
+
+static void onTx( avr_irq_t*, uint32_t value, void* )
+{
+	tx += (char)value;
+}
+
+
+/// let the target run for `ms` milliseconds
+static void run( uint32_t ms )
+{
+	avr_cycle_count_t end = avr->cycle + (avr_cycle_count_t)avr->frequency / 1000 * ms;
+	while (avr->cycle < end) {
+		int state = avr_run( avr );
+		if (state == cpu_Done || state == cpu_Crashed) {
+			printf( "target stopped at cycle %llu\n", (unsigned long long)avr->cycle );
+			exit( 2 );
+		}
+	}
+}
+
+
+/// set the input of button `i` to `level` for `ms` milliseconds
+static void button( uint8_t i, uint8_t level, uint32_t ms )
+{
+	avr_raise_irq( avr_io_getirq( avr, AVR_IOCTL_IOPORT_GETIRQ('B'), i ), level );
+	run( ms );
+}
+
+
+/// send `cmd` and @return the reply, i.e. everything sent within 100 ms
+static std::string command( const char* cmd )
+{
+	tx.clear();
+	for (const char* p = cmd; *p; p++)
+		avr_raise_irq( uartIn, (uint8_t)*p );
+	run( 100 );
+	return tx;
+}
+
+
+/// @return `s` with CR and LF made visible
+static std::string visible( const std::string& s )
+{
+	std::string v;
+	for (char c : s) v += (c == '\r') ? "\\r" : (c == '\n') ? "\\n" : std::string( 1, c );
+	return v;
+}
+
+
+/// send `cmd`, compare the reply with `expected`
+static void expect( const char* name, const char* cmd, const char* expected )
+{
+	std::string got = command( cmd );
+	bool ok = got == expected;
+	printf( "console: %-26s %s\n", name, ok ? "ok" : "WRONG" );
+	if (!ok) {
+		printf( "  got      \"%s\"\n  expected \"%s\"\n", visible( got ).c_str(), visible( expected ).c_str() );
+		bad++;
+	}
+}
+
+
+int main( int argc, char* argv[] )
+{
+	if (argc < 2) {
+		printf( "usage: sim <elf file>\n" );
+		return 2;
+	}
+
+	elf_firmware_t fw = {};
+	if (elf_read_firmware( argv[1], &fw ) != 0) {
+		printf( "cannot read %s\n", argv[1] );
+		return 2;
+	}
+	avr = avr_make_mcu_by_name( fw.mmcu[0] ? fw.mmcu : "atmega328p" );
+	if (!avr) {
+		printf( "unknown MCU %s\n", fw.mmcu );
+		return 2;
+	}
+	avr_init( avr );
+	avr_load_firmware( avr, &fw );
+
+	// collect the output here instead of simavr printing it
+	uint32_t flags = 0;
+	avr_ioctl( avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags );
+	flags &= ~AVR_UART_FLAG_STDIO;
+	avr_ioctl( avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags );
+	avr_irq_register_notify( avr_io_getirq( avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT ), onTx, NULL );
+	uartIn = avr_io_getirq( avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT );
+
+	run( 200 );
+	expect( "show, idle", "s\r",
+		"#0 down=0 P=0 R=0 S=0 L=0 D=0 raw=0\r\n"
+		"#1 down=0 P=0 R=0 S=0 L=0 D=0 raw=0\r\n"
+		"long=1000 double=200\r\n" );
+
+	// #0: short press, #1: long press, #0: double click
+	button( 0, 1, 100 );	button( 0, 0, 600 );
+	button( 1, 1, 1500 );	button( 1, 0, 600 );
+	button( 0, 1, 100 );	button( 0, 0, 100 );
+	button( 0, 1, 100 );	button( 0, 0, 600 );
+	expect( "show, after presses", "s\r",
+		"#0 down=0 P=3 R=3 S=1 L=0 D=1 raw=6\r\n"
+		"#1 down=0 P=1 R=1 S=0 L=1 D=0 raw=2\r\n"
+		"long=1000 double=200\r\n" );
+
+	expect( "long press threshold", "l 1500\r", "long=1500 double=200\r\n" );
+	expect( "double click window", "d 300\n", "long=1500 double=300\r\n" );
+	expect( "long press, clamped", "l 65000\r", "long=60000 double=300\r\n" );
+	expect( "thresholds, no argument", "l\r", "long=60000 double=300\r\n" );
+
+	// 1.5 s is a short press now
+	button( 1, 1, 1500 );	button( 1, 0, 600 );
+	expect( "show, new thresholds", "s\r",
+		"#0 down=0 P=3 R=3 S=1 L=0 D=1 raw=6\r\n"
+		"#1 down=0 P=2 R=2 S=1 L=1 D=0 raw=4\r\n"
+		"long=60000 double=300\r\n" );
+
+	// ISR duration, in Timer1 counts at F_CPU: more than nothing, less than a tick
+	std::string got = command( "c\r" );
+	unsigned last = 0, max = 0;
+	bool ok = sscanf( got.c_str(), "isr last=%u max=%u", &last, &max ) == 2
+		&& last > 0 && last <= max && max < avr->frequency / 1000 * 10;
+	printf( "console: %-26s %s\n", "ISR budget", ok ? "ok" : "WRONG" );
+	if (!ok) {
+		printf( "  got \"%s\"\n", visible( got ).c_str() );
+		bad++;
+	}
+
+	expect( "reset", "z\r", "ok\r\n" );
+	expect( "show, after reset", "s\r",
+		"#0 down=0 P=0 R=0 S=0 L=0 D=0 raw=0\r\n"
+		"#1 down=0 P=0 R=0 S=0 L=0 D=0 raw=0\r\n"
+		"long=60000 double=300\r\n" );
+	expect( "unknown command", "x\r", "?\r\n" );
+	expect( "empty line", "\r\n", "" );
+	expect( "line too long", "s xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\r",
+		"#0 down=0 P=0 R=0 S=0 L=0 D=0 raw=0\r\n"
+		"#1 down=0 P=0 R=0 S=0 L=0 D=0 raw=0\r\n"
+		"long=60000 double=300\r\n" );
+
+	return bad ? 1 : 0;
+}
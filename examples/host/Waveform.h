@@ -0,0 +1,217 @@
+/**
+ * @file          Waveform.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef WAVEFORM_H_
+#define WAVEFORM_H_
+
+/*
+	Host builds only: synthetic contact signals with realistic defects, to drive
+	benchmarks of the debouncer instead of clean steps.
+*/
+
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Parameters of a synthetic contact signal. Times in ms, rates per s.
+ * All defects are off by default, so the default is clean presses with human timing.
+ */
+struct WaveformParams {
+	// human timing, log-normal: median and sigma of ln
+	double		pressMedianMs = 150;	///< median press duration
+	double		pressSigma = 0.6;
+	double		gapMedianMs = 400;		///< median time between presses
+	double		gapSigma = 0.8;
+
+	// contact bounce at both edges
+	double		bounces = 0;			///< mean # of bounces per edge, Poisson
+	double		bounceMs = 0.5;			///< mean duration of one bounce, exponential
+	double		bounceMaxMs = 10;		///< bounce ends after this, at the latest
+
+	// EMI spikes, anywhere
+	double		spikeRate = 0;			///< mean # of spikes per s, Poisson
+	double		spikeMs = 0.05;			///< mean spike width, exponential
+
+	// slow edges, e.g. RC filter or long cable: the input crosses the logic threshold
+	// slowly, so noise makes it chatter around the crossing
+	double		slowEdgeMs = 0;			///< rise and fall time, 0 = sharp edges
+	double		slowNoise = 0.05;		///< noise, relative to the full swing
+
+	// reed switch chatter: the magnet holds the reed near its threshold, so it
+	// vibrates at its resonance for a while after each edge
+	double		chatterMs = 0;			///< duration of chatter after each edge
+	double		chatterPeriodMs = 0.4;	///< period of one open/close cycle
+};
+
+
+/**
+ * @brief A generated contact signal, with the intended presses as ground truth.
+ *
+ * The signal is a list of level changes in µs, generated once, so it can be sampled
+ * at any rate and phase. EMI spikes are kept as a separate list and inverted into the
+ * signal while sampling.
+ */
+class Waveform {
+	public:
+		/// an intended press, from the first contact to the last release [µs]
+		struct Press {
+			uint64_t	start;
+			uint64_t	end;
+		};
+
+	private:
+		struct Change {
+			uint64_t	t;
+			uint8_t		level;
+		};
+		std::vector<Change>		mChanges;		// base signal, sorted by time
+		std::vector<Press>		mSpikes;		// intervals where the signal is inverted
+		std::vector<Press>		mPresses;
+		uint64_t				mEnd;
+		std::mt19937_64			mRnd;
+
+		// sampling cursors
+		size_t					mChange;
+		size_t					mSpike;
+		uint64_t				mLast;
+
+		static uint64_t us( double ms ) { return (ms > 0) ? (uint64_t)(ms * 1000.0 + 0.5) : 0; }
+
+		double exponential( double mean ) { return std::exponential_distribution<double>( 1.0 / mean )( mRnd ); }
+
+		void push( uint64_t t, uint8_t level ) {
+			if (!mChanges.empty() && mChanges.back().t >= t) t = mChanges.back().t + 1;
+			if (mChanges.empty() || mChanges.back().level != level) mChanges.push_back( { t, level } );
+		}
+
+		/// an edge to `level` at `t`, with defects, that must be done before `limit`
+		void edge( const WaveformParams& p, uint64_t t, uint8_t level, uint64_t limit ) {
+			uint64_t t0 = t;
+			if (p.slowEdgeMs > 0) {
+				// ramp through the threshold, with noise, sampled every 10 µs
+				std::normal_distribution<double> noise( 0, p.slowNoise );
+				uint64_t len = us( p.slowEdgeMs );
+				for (uint64_t u=0; u<=len; u+=10) {
+					double r = (double)u / len + noise( mRnd );
+					push( t0 - len/2 + u, (r > 0.5) ? level : !level );
+				}
+				t = t0 + len/2;
+			}
+			push( t, level );
+
+			if (p.chatterMs > 0) {
+				uint64_t stop = std::min( t + us( p.chatterMs ), limit );
+				uint64_t half = std::max<uint64_t>( us( p.chatterPeriodMs ) / 2, 1 );
+				std::uniform_int_distribution<uint64_t> jitter( half/2, half + half/2 );
+				uint64_t u = t;
+				while (u + 2*half < stop) {
+					u += jitter( mRnd ); push( u, !level );
+					u += jitter( mRnd ); push( u, level );
+				}
+				t = u;
+			}
+
+			if (p.bounces > 0) {
+				unsigned n = std::poisson_distribution<unsigned>( p.bounces )( mRnd );
+				uint64_t stop = std::min( t + us( p.bounceMaxMs ), limit );
+				uint64_t u = t;
+				for (unsigned i=0; i<n; i++) {
+					uint64_t away = u + 1 + us( exponential( p.bounceMs ) );
+					uint64_t back = away + 1 + us( exponential( p.bounceMs ) );
+					if (back >= stop) break;
+					push( away, !level );
+					push( back, level );
+					u = back;
+				}
+			}
+		}
+
+	public:
+		explicit Waveform( uint64_t seed = 1 ) : mEnd(0), mRnd(seed), mChange(0), mSpike(0), mLast(0) {}
+
+		/**
+		 * @brief Generate `count` presses, replacing any previous signal.
+		 * A press gets at most its own duration for its defects, and so does a gap.
+		 */
+		void generate( const WaveformParams& p, unsigned count ) {
+			std::lognormal_distribution<double> press( log( p.pressMedianMs ), p.pressSigma );
+			std::lognormal_distribution<double> gap( log( p.gapMedianMs ), p.gapSigma );
+
+			mChanges.clear();
+			mSpikes.clear();
+			mPresses.clear();
+			mChanges.push_back( { 0, 0 } );
+
+			uint64_t t = us( p.slowEdgeMs ) + us( p.gapMedianMs );
+			for (unsigned i=0; i<count; i++) {
+				uint64_t d = std::max<uint64_t>( us( press( mRnd ) ), 1000 );
+				uint64_t g = std::max<uint64_t>( us( gap( mRnd ) ), 1000 ) + us( p.slowEdgeMs );
+				edge( p, t, 1, t + d );
+				edge( p, t + d, 0, t + d + g );
+				mPresses.push_back( { t, t + d } );
+				t += d + g;
+			}
+			mEnd = t;
+
+			if (p.spikeRate > 0) {
+				double s = 0;
+				for (;;) {
+					s += exponential( 1e6 / p.spikeRate );
+					if (s >= mEnd) break;
+					uint64_t a = (uint64_t)s;
+					mSpikes.push_back( { a, a + 1 + us( exponential( p.spikeMs ) ) } );
+				}
+			}
+			rewind();
+		}
+
+		/// start sampling from time 0 again
+		void rewind() { mChange = 0; mSpike = 0; mLast = 0; }
+
+		/// @brief Level at time `t` [µs], for non-decreasing `t` since `rewind()`
+		uint8_t at( uint64_t t ) {
+			if (t < mLast) rewind();
+			mLast = t;
+			while (mChange+1 < mChanges.size() && mChanges[mChange+1].t <= t) mChange++;
+			while (mSpike < mSpikes.size() && mSpikes[mSpike].end <= t) mSpike++;
+			uint8_t level = mChanges[mChange].level;
+			if (mSpike < mSpikes.size() && mSpikes[mSpike].start <= t) level ^= 1;
+			return level;
+		}
+
+		/// the intended presses, in order
+		const std::vector<Press>& presses() const { return mPresses; }
+		/// end of the signal [µs]
+		uint64_t end() const { return mEnd; }
+		/// # of level changes in the signal, without spikes
+		size_t changes() const { return mChanges.size(); }
+};
+
+
+/** @} */
+
+#endif /* WAVEFORM_H_ */
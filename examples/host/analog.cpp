@@ -0,0 +1,289 @@
+/**
+ * @file 		  analog.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Check analog inputs with simulated ADC readings, fed via `next()`.
+ *
+ * - schmitt: 4 contacts on one `AnalogScanner`, closed at 200 and open at 600, with
+ *   slow drift of up to +-80 and noise of +-30 per reading, thresholds 350/450.
+ *   Each input must count exactly its closures. Then readings anywhere inside the
+ *   hysteresis band must cause no edges.
+ * - zones: `ZoneThresholds` at the band limits, then 40 EOL zones on 5 multiplexer
+ *   banks of one `ZoneScanner`, with random state changes, noise of +-20 and random
+ *   full-scale spikes. Final states and alarm/tamper counts must match the inputs.
+ * - alarm: 16 EOL zones feed `AlarmZones` with 4 zones of 4 contacts, via the scanner's
+ *   `alarmMask` and `tamperMask`, with arming and disarming in between. Masks, open,
+ *   alarm and tamper bits must match a reference model after every reading.
+ * - add: `add()` must refuse more than BUTTON_ANALOG_MAX inputs, and inputs that would
+ *   make the time per sample exceed 255 ms.
+ *
+ * usage: analog [rounds] [seed]
+ * Exit code is 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ButtonAnalog.h>
+#include <ButtonZone.h>
+#include <ButtonAlarm.h>
+
+#define NINPUTS		4
+#define NZONES		40
+
+
+/// uniform in [-r, r]
+static int noise( int r )
+{
+	return rand() % (2*r+1) - r;
+}
+
+
+/// @return # of failed checks
+static unsigned schmitt( unsigned long rounds )
+{
+	AnalogScanner scanner;
+	AnalogButton inputs[NINPUTS];
+	int drift[NINPUTS] = { 0 };
+	uint8_t closed[NINPUTS] = { 0 };
+	unsigned run[NINPUTS] = { 0 };
+	unsigned long closures[NINPUTS] = { 0 }, presses[NINPUTS] = { 0 };
+	unsigned bad = 0;
+
+	scanner.init();
+	for (uint8_t i=0; i<NINPUTS; i++) {
+		// pressed = closed = low reading, channels in reverse order
+		inputs[i].init( NINPUTS-1-i, 350, 450, true );
+		if (!scanner.add( &inputs[i] )) bad++;
+	}
+
+	for (unsigned long n=0; n<rounds*NINPUTS; n++) {
+		uint8_t i = NINPUTS-1 - scanner.channel();
+		if (run[i] == 0) {
+			// each state lasts long enough to be debounced, in samples of this input
+			closed[i] = !closed[i];
+			if (closed[i]) {
+				// cPressed saturates, so move it to the total
+				closures[i]++;
+				presses[i] += inputs[i].cPressed;
+				inputs[i].cPressed = 0;
+			}
+			run[i] = BUTTON_NTICKS + 1 + rand() % 40;
+		}
+		run[i]--;
+		if (rand() % 8 == 0) drift[i] += (rand() % 2) ? (drift[i] < 80) : -(drift[i] > -80);
+		scanner.next( (uint16_t)((closed[i] ? 200 : 600) + drift[i] + noise( 30 )) );
+	}
+	// end released, so the last closure has been debounced
+	for (unsigned n=0; n<(BUTTON_NTICKS+1)*NINPUTS; n++)
+		scanner.next( 600 );
+
+	for (uint8_t i=0; i<NINPUTS; i++) {
+		presses[i] += inputs[i].cPressed;
+		bool ok = presses[i] == closures[i] && !inputs[i].isDown;
+		printf( "schmitt: input %u: %lu presses for %lu closures, %s\n",
+			i, presses[i], closures[i], ok ? "ok" : "WRONG" );
+		if (!ok) bad++;
+	}
+
+	// closed, band, open, band: readings inside the band must not change the level
+	const unsigned cycles = 200;
+	for (uint8_t i=0; i<NINPUTS; i++) inputs[i].cPressed = inputs[i].cReleased = 0;
+	for (unsigned c=0; c<cycles; c++) {
+		for (uint8_t phase=0; phase<4; phase++) {
+			for (unsigned n=0; n<(phase & 1 ? 100 : BUTTON_NTICKS + 1) * NINPUTS; n++) {
+				uint16_t v = (phase == 0) ? 200 : (phase == 2) ? 600 : 351 + rand() % 99;
+				scanner.next( v );
+			}
+		}
+	}
+	for (uint8_t i=0; i<NINPUTS; i++) {
+		bool ok = inputs[i].cPressed == cycles && inputs[i].cReleased == cycles;
+		printf( "schmitt: input %u: %u presses and %u releases for %u crossings of the band, %s\n",
+			i, inputs[i].cPressed, inputs[i].cReleased, cycles, ok ? "ok" : "WRONG" );
+		if (!ok) bad++;
+	}
+	return bad;
+}
+
+
+/// @return # of failed checks
+static unsigned zones( unsigned long rounds )
+{
+	// 4k7 EOL, 4k7 alarm resistor, 4k7 pull-up, 10-bit ADC
+	const ZoneThresholds t = { 256, 597, 852 };
+	const uint16_t nominal[4] = { 512, 682, 1023, 0 };		// by ZoneState
+	const struct { uint16_t v; uint8_t s; } limits[] = {
+		{ 0, ZONE_SHORT }, { 256, ZONE_SHORT }, { 257, ZONE_NORMAL }, { 597, ZONE_NORMAL },
+		{ 598, ZONE_ALARM }, { 852, ZONE_ALARM }, { 853, ZONE_CUT }, { 1023, ZONE_CUT } };
+	unsigned bad = 0;
+
+	for (auto& l : limits) {
+		if (t.classify( l.v ) != l.s) {
+			printf( "zones: %u classified as %u, not %u\n", l.v, t.classify( l.v ), l.s );
+			bad++;
+		}
+	}
+
+	ZoneInput zones[NZONES];
+	ZoneScanner scanner( zones, NZONES );
+	uint8_t state[NZONES] = { 0 };
+	unsigned run[NZONES] = { 0 };
+	unsigned long alarms[NZONES] = { 0 }, tampers[NZONES] = { 0 };
+
+	// 8 channels per bank, bank in the upper 4 bits
+	for (uint8_t i=0; i<NZONES; i++) zones[i].init( ((i / 8) << 4) | (i % 8) );
+	scanner.limits = t;
+
+	for (unsigned long n=0; n<rounds*NZONES; n++) {
+		uint8_t ch = scanner.channel();
+		uint8_t i = (ch >> 4) * 8 + (ch & 0x0F);
+		if (run[i] == 0) {
+			state[i] = (state[i] + 1 + rand() % 3) % 4;
+			if (state[i] == ZONE_ALARM) alarms[i]++;
+			else if (state[i] != ZONE_NORMAL) tampers[i]++;
+			run[i] = BUTTON_ZONE_SAMPLES + 5 + rand() % 30;
+		}
+		run[i]--;
+		int v = nominal[state[i]] + noise( 20 );
+		if (rand() % 100 == 0) v = (rand() % 2) ? 1023 : 0;
+		scanner.next( (uint16_t)(v < 0 ? 0 : v > 1023 ? 1023 : v) );
+	}
+	// hold the last states until they are debounced
+	for (unsigned long n=0; n<(BUTTON_ZONE_SAMPLES+1)*NZONES; n++) {
+		uint8_t ch = scanner.channel();
+		scanner.next( nominal[state[(ch >> 4) * 8 + (ch & 0x0F)]] );
+	}
+
+	unsigned wrong = 0;
+	unsigned long changes = 0;
+	for (uint8_t i=0; i<NZONES; i++) {
+		// counts saturate at 255, none gets near that here
+		if (zones[i].state != state[i] || zones[i].cAlarm != alarms[i] || zones[i].cTamper != tampers[i]) {
+			if (wrong < 5)
+				printf( "zones: zone %u: state %u/%u, alarms %u/%lu, tampers %u/%lu\n", i,
+					(unsigned)zones[i].state, state[i], (unsigned)zones[i].cAlarm, alarms[i],
+					(unsigned)zones[i].cTamper, tampers[i] );
+			wrong++;
+		}
+		changes += alarms[i] + tampers[i];
+	}
+	printf( "zones: %u zones, %lu changes to alarm or tamper, %u zones wrong\n", NZONES, changes, wrong );
+	return bad + wrong;
+}
+
+
+/// @return # of readings after which `AlarmZones` and the model disagreed
+static unsigned long alarm( unsigned long rounds )
+{
+	const uint16_t nominal[4] = { 512, 682, 1023, 0 };
+	ZoneInput inputs[16];
+	ZoneScanner scanner( inputs, 16 );
+	AlarmZones zones;
+	uint8_t level[16] = { 0 };
+	unsigned run[16] = { 0 };
+	ZoneMask open = 0, armed = 0, alarm = 0, tamper = 0;
+	unsigned long bad = 0, alarms = 0, tampers = 0;
+
+	for (uint8_t i=0; i<16; i++) inputs[i].init( i );
+	scanner.limits = ZoneThresholds{ 256, 597, 852 };
+	for (uint8_t z=0; z<4; z++) zones.add( (ButtonMask)(0x000F << (4*z)) );
+
+	for (unsigned long n=0; n<rounds*16; n++) {
+		if (n % 2000 == 0) {
+			// disarm all, arm zones 0 and 1
+			zones.disarm( 0x0F );
+			armed = alarm = tamper = 0;
+			ZoneMask refused = zones.arm( 0x03 );
+			if (refused != (0x03 & open)) bad++;
+			armed = 0x03 & ~open;
+		}
+		uint8_t i = scanner.channel();
+		if (run[i] == 0) {
+			// mostly normal, sometimes alarm, rarely cut or short
+			int r = rand() % 100;
+			level[i] = (r < 60) ? ZONE_NORMAL : (r < 98) ? ZONE_ALARM : (r < 99) ? ZONE_CUT : ZONE_SHORT;
+			run[i] = BUTTON_ZONE_SAMPLES + 5 + rand() % 100;
+		}
+		run[i]--;
+		scanner.next( nominal[level[i]] );
+		zones.tick( scanner.alarmMask, scanner.tamperMask );
+
+		// model, from the debounced states
+		ButtonMask down = 0, cut = 0;
+		for (uint8_t k=0; k<16; k++) {
+			if (inputs[k].state == ZONE_ALARM) down |= 1 << k;
+			if (inputs[k].state == ZONE_CUT || inputs[k].state == ZONE_SHORT) cut |= 1 << k;
+		}
+		ZoneMask now = 0, t = 0;
+		for (uint8_t z=0; z<4; z++) {
+			if ((down | cut) & (0x000F << (4*z))) now |= 1 << z;
+			if (cut & (0x000F << (4*z))) t |= 1 << z;
+		}
+		alarm |= now & ~open & armed;
+		tamper |= t;
+		open = now;
+		alarms += alarm != 0;
+		tampers += tamper != 0;
+
+		if (scanner.alarmMask != down || scanner.tamperMask != cut || zones.open != open
+				|| zones.alarm != alarm || zones.tamper != tamper) {
+			if (bad < 5)
+				printf( "alarm: reading %lu: masks %04X/%04X %04X/%04X, open %02X/%02X, alarm %02X/%02X, tamper %02X/%02X\n",
+					n, (unsigned)scanner.alarmMask, down, (unsigned)scanner.tamperMask, cut,
+					(unsigned)zones.open, open, (unsigned)zones.alarm, alarm, (unsigned)zones.tamper, tamper );
+			bad++;
+		}
+	}
+	printf( "alarm: %lu readings, %lu with an alarm, %lu with a tamper bit, %lu wrong\n",
+		rounds*16, alarms, tampers, bad );
+	return bad;
+}
+
+
+/// @return # of failed checks
+static unsigned add()
+{
+	AnalogScanner scanner;
+	AnalogButton inputs[BUTTON_ANALOG_MAX+1];
+	unsigned added = 0, slow = 0;
+
+	scanner.init( 10 );
+	for (AnalogButton& b : inputs) added += scanner.add( &b );
+	// 100 ms per tick: 2 inputs take 200 ms per sample, 3 would take 300
+	scanner.init( 100 );
+	for (AnalogButton& b : inputs) slow += scanner.add( &b );
+
+	bool ok = added == BUTTON_ANALOG_MAX && slow == 2;
+	printf( "add: %u of %u inputs at 10 ms, %u at 100 ms, %s\n",
+		added, BUTTON_ANALOG_MAX+1, slow, ok ? "ok" : "WRONG" );
+	return ok ? 0 : 1;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	unsigned long rounds = (argc > 1) ? atol( argv[1] ) : 100000;
+	srand( (argc > 2) ? atoi( argv[2] ) : 5 );
+
+	unsigned bad = schmitt( rounds );
+	bad += zones( rounds / 50 );
+	bad += alarm( rounds / 10 );
+	bad += add();
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file 		  await.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Many coroutine handlers waiting for button events, for a host build with
+ * C++20 and BUTTON_EVENTS.
+ *
+ * Starts `handlers` coroutines, each waits in a loop for one event kind on one of
+ * NBUTTONS buttons. The buttons are ticked with random input, then the event queue
+ * is dispatched. At the end, each handler must have seen exactly the events that a
+ * plain listener counted for its button and kind, and no memory may have been
+ * allocated after the handlers were started. Waits for event values that are not
+ * an event kind must complete at once with `Event::Invalid`.
+ *
+ * usage: await [handlers] [ticks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <vector>
+#include <chrono>
+
+#include <ButtonAwait.h>
+
+#define NBUTTONS	16
+
+static ButtonCore		buttons[NBUTTONS];
+static unsigned long	expected[NBUTTONS][BUTTON_EVENT_KINDS];
+static unsigned long	allocations;
+
+
+void* operator new( size_t n )
+{
+	allocations++;
+	void* p = malloc( n );
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete( void* p ) noexcept { free( p ); }
+void operator delete( void* p, size_t ) noexcept { free( p ); }
+
+
+static void count( uint8_t event, uint8_t button )
+{
+	expected[button][event]++;
+}
+
+
+static ButtonTask handler( AwaitButton b, ButtonAwait::Event ev, unsigned long* seen )
+{
+	for (;;) {
+		ButtonAwait::Event got = co_await b.next( ev );
+		if (got == ev) (*seen)++;
+	}
+}
+
+
+/// wait once, for an event that may not be a valid kind
+static ButtonTask probe( AwaitButton b, ButtonAwait::Event ev, ButtonAwait::Event* got )
+{
+	*got = co_await b.next( ev );
+}
+
+
+int main( int argc, char* argv[] )
+{
+	unsigned nhandlers = (argc > 1) ? atoi( argv[1] ) : 5000;
+	unsigned long nticks = (argc > 2) ? atol( argv[2] ) : 1000000;
+	const ButtonAwait::Event kinds[] = {
+		ButtonAwait::Event::Press, ButtonAwait::Event::Release,
+		ButtonAwait::Event::ShortPress, ButtonAwait::Event::LongPress,
+		ButtonAwait::Event::DoublePress };
+	std::vector<AwaitButton> handles;
+	std::vector<unsigned long> seen( nhandlers );
+
+	for (int i=0; i<NBUTTONS; i++) {
+		buttons[i].init();
+		handles.emplace_back( &buttons[i] );
+	}
+	buttonEvents.subscribe( count, 0xFF, (ButtonMask)~0 );
+
+	unsigned long invalid = 0;
+	const ButtonAwait::Event bogus[] = { ButtonAwait::Event::Invalid, (ButtonAwait::Event)BUTTON_EVENT_KINDS };
+	for (ButtonAwait::Event ev : bogus) {
+		ButtonAwait::Event got = ButtonAwait::Event::Press;
+		probe( handles[0], ev, &got );
+		if (got != ButtonAwait::Event::Invalid) invalid++;
+	}
+	if (ButtonAwait::instance().waiting() != 0) invalid++;
+	printf( "%lu invalid waits not completed at once\n", invalid );
+
+	for (unsigned k=0; k<nhandlers; k++)
+		handler( handles[k % NBUTTONS], kinds[(k / NBUTTONS) % 5], &seen[k] );
+	printf( "%lu handlers waiting\n", ButtonAwait::instance().waiting() );
+
+	unsigned long before = allocations;
+	uint32_t rnd = 1;
+	int run[NBUTTONS] = {0};
+	uint8_t level[NBUTTONS] = {0};
+	unsigned long events = 0;
+	auto t0 = std::chrono::steady_clock::now();
+
+	for (unsigned long n=0; n<nticks; n++) {
+		for (int i=0; i<NBUTTONS; i++) {
+			if (--run[i] <= 0) {
+				rnd = rnd * 1103515245u + 12345u;
+				level[i] = !level[i];
+				uint32_t r = (rnd >> 16) % 100;
+				run[i] = (r < 20) ? 1 + r % 3 : (r < 90) ? 5 + r : 100 + 10 * r;
+			}
+			buttons[i].tick( level[i] );
+		}
+		events += buttonEvents.dispatch();
+	}
+
+	double secs = std::chrono::duration<double>( std::chrono::steady_clock::now() - t0 ).count();
+	unsigned long bad = 0, resumes = 0;
+	for (unsigned k=0; k<nhandlers; k++) {
+		if (seen[k] != expected[k % NBUTTONS][(uint8_t)kinds[(k / NBUTTONS) % 5]]) bad++;
+		resumes += seen[k];
+	}
+	printf( "%lu events, %lu resumes in %.2f s, %lu handlers wrong, %lu allocations, %u dropped\n",
+		events, resumes, secs, bad, allocations - before, buttonEvents.cDropped );
+	return (bad || invalid || allocations != before || buttonEvents.cDropped) ? 1 : 0;
+}
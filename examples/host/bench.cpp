@@ -0,0 +1,140 @@
+/**
+ * @file 		  bench.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Detection latency and false events of the debouncer, for synthetic contact signals.
+ *
+ * For each kind of signal defect and each tick interval, a `Waveform` with `presses`
+ * human presses is sampled at that interval and fed to a `ButtonCore`. Each debounced
+ * press is matched to the intended press it falls into:
+ * - latency: from the start of the intended press to the debounced press
+ * - missed: intended presses without a debounced press
+ * - false: debounced presses beyond the first in an intended press, or outside any
+ * Time per tick also goes to `setMillisPerTick()`, so gesture timing stays right.
+ * The debounce depth is a build option: `make bench NTICKS=5`.
+ *
+ * usage: bench [presses] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <Button.h>
+#include "Waveform.h"
+
+struct Scenario {
+	const char*		name;
+	WaveformParams	p;
+};
+
+struct Result {
+	double			meanMs;
+	double			p99Ms;
+	unsigned		missed;
+	unsigned		falses;
+};
+
+
+static Result run( Waveform& w, uint8_t tickMs, uint64_t phase )
+{
+	ButtonCore b;
+	std::vector<double> latency;
+	const std::vector<Waveform::Press>& presses = w.presses();
+	size_t k = 0;			// first intended press that may still match
+	bool matched = false;	// presses[k] has a debounced press
+	Result r = { 0, 0, 0, 0 };
+
+	b.setMillisPerTick( tickMs );
+	w.rewind();
+	uint64_t step = (uint64_t)tickMs * 1000;
+	for (uint64_t t=phase; t<w.end(); t+=step) {
+		if (b.tickInline( w.at( t ) ) != Debounce::PRESS) continue;
+
+		// skip intended presses that are over: the next one has started, or the release
+		// should have been debounced by now
+		while (k < presses.size() && ((k+1 < presses.size() && t >= presses[k+1].start)
+				|| t > presses[k].end + (BUTTON_NTICKS+1) * step)) {
+			if (!matched) r.missed++;
+			k++;
+			matched = false;
+		}
+		if (k < presses.size() && t >= presses[k].start && !matched) {
+			latency.push_back( (t - presses[k].start) / 1000.0 );
+			matched = true;
+		} else {
+			r.falses++;
+		}
+	}
+	for ( ; k < presses.size(); k++, matched = false)
+		if (!matched) r.missed++;
+
+	if (!latency.empty()) {
+		double sum = 0;
+		for (double l : latency) sum += l;
+		r.meanMs = sum / latency.size();
+		std::sort( latency.begin(), latency.end() );
+		r.p99Ms = latency[ latency.size() * 99 / 100 ];
+	}
+	return r;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	unsigned count = (argc > 1) ? atoi( argv[1] ) : 20000;
+	uint64_t seed = (argc > 2) ? atol( argv[2] ) : 1;
+	const uint8_t ticks[] = { 1, 2, 5, 10, 20 };
+	std::vector<Scenario> scenarios( 6 );
+
+	scenarios[0].name = "clean";
+	scenarios[1].name = "bounce";
+	scenarios[1].p.bounces = 4;
+	scenarios[1].p.bounceMs = 0.8;
+	scenarios[2].name = "emi";
+	scenarios[2].p.spikeRate = 20;
+	scenarios[2].p.spikeMs = 0.5;
+	scenarios[3].name = "slow";
+	scenarios[3].p.slowEdgeMs = 8;
+	scenarios[3].p.slowNoise = 0.1;
+	scenarios[4].name = "reed";
+	scenarios[4].p.chatterMs = 6;
+	scenarios[4].p.chatterPeriodMs = 1.5;
+	scenarios[5].name = "all";
+	scenarios[5].p = scenarios[1].p;
+	scenarios[5].p.spikeRate = 20;
+	scenarios[5].p.spikeMs = 0.5;
+	scenarios[5].p.slowEdgeMs = 8;
+	scenarios[5].p.slowNoise = 0.1;
+	scenarios[5].p.chatterMs = 6;
+	scenarios[5].p.chatterPeriodMs = 1.5;
+
+	printf( "BUTTON_NTICKS=%d, %u presses per run\n", BUTTON_NTICKS, count );
+	printf( "%-8s %5s %10s %10s %12s %12s\n", "signal", "tick", "mean [ms]", "p99 [ms]", "missed/1000", "false/1000" );
+	for (Scenario& s : scenarios) {
+		Waveform w( seed );
+		w.generate( s.p, count );
+		for (uint8_t tick : ticks) {
+			Result r = run( w, tick, (seed * 7919 + tick * 104729) % (tick * 1000u) );
+			printf( "%-8s %5u %10.1f %10.1f %12.2f %12.2f\n", s.name, tick, r.meanMs, r.p99Ms,
+				1000.0 * r.missed / count, 1000.0 * r.falses / count );
+		}
+	}
+	return 0;
+}
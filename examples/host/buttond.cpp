@@ -0,0 +1,637 @@
+/**
+ * @file 		  buttond.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Linux daemon: debounce many contacts with the `Button` logic, publish gestures.
+ *
+ * Single thread, driven by `epoll`. Inputs deliver level changes, the input level is
+ * held between changes and sampled on every tick, just like a pin read from a timer ISR.
+ * Input backends:
+ * - `-f path`		named pipe or `-` for stdin, lines "<id> <level>", e.g. a test script
+ * - `-d tty[:baud]`	serial port, same line format, e.g. a board that reports its inputs
+ * - `-g chip:off,off,..[:low]`	lines of a GPIO character device, edge events via the
+ * 					GPIO v2 uAPI, max 64 lines per `-g`, ids are assigned after the `-n` range
+ *
+ * Ticks come from a `timerfd`. Only inputs that are debouncing or have a pending short
+ * press are ticked (see `nextWakeupTicks()`), the others are caught up with `skipMillis()`
+ * when their input changes, and the timer is stopped while no input is active. So the
+ * CPU time depends on the input activity, not on the number of inputs.
+ *
+ * Clients connect to a Unix stream socket and receive one line per event:
+ * "<id> press|release|short|long|double". Lines are buffered per client and sent
+ * once per loop iteration; a client that can't keep up loses whole lines.
+ *
+ * usage: buttond [-s socket] [-t ms_per_tick] [-n inputs] -f|-d|-g ...
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <string>
+#include <vector>
+
+#include <Button.h>
+
+
+/// something registered with epoll
+class Pollable {
+	public:
+		virtual ~Pollable() {}
+		virtual void onEvent( uint32_t events ) = 0;
+};
+
+
+class Daemon;
+
+
+/// @brief Source of input level changes.
+class Input : public Pollable {
+	protected:
+		Daemon&		mDaemon;
+		int			mFd;
+
+	public:
+		Input( Daemon& d ) : mDaemon( d ), mFd( -1 ) {}
+		virtual ~Input() { if (mFd >= 0) close( mFd ); }
+		int fd() const { return mFd; }
+};
+
+
+/// one debounced input
+struct Channel {
+	ButtonCore	button;
+	uint8_t		level;
+	bool		active;			// on the active list, ticked every tick
+	uint32_t	lastTick;		// when inactive: tick up to which button is up to date
+};
+
+
+/// @brief Unix socket server, broadcasts event lines to all clients.
+class Publisher : public Pollable {
+	private:
+		class Client : public Pollable {
+			public:
+				Publisher&	mOwner;
+				int			mFd;
+				std::string	mOut;		// not yet sent
+				bool		mWaiting;	// waiting for EPOLLOUT
+				Client( Publisher& p, int fd ) : mOwner( p ), mFd( fd ), mWaiting( false ) {}
+				void onEvent( uint32_t events ) override;
+				void send();
+		};
+		int						mEpoll;
+		int						mFd;
+		std::vector<Client*>	mClients;
+
+		void drop( Client* c );
+
+	public:
+		Publisher() : mEpoll( -1 ), mFd( -1 ) {}
+		bool open( int epoll, const char* path );
+		void onEvent( uint32_t events ) override;
+		void publish( const char* line, size_t len );
+		void flush();
+		size_t clients() const { return mClients.size(); }
+
+		/// max # of bytes buffered per client
+		static const size_t	MAX_BUFFERED = 256 * 1024;
+};
+
+
+/**
+ * @brief The tick engine: channels, active list, timer.
+ */
+class Daemon : public Pollable {
+	private:
+		int						mEpoll;
+		int						mTimer;
+		uint8_t					mMillisPerTick;
+		bool					mRunning;			// timer armed
+		uint32_t				mTick;				// last tick processed
+		struct timespec			mStart;
+		std::vector<Channel>	mChannels;
+		std::vector<uint32_t>	mActive;
+		Publisher				mPublisher;
+
+		uint32_t currentTick() const;
+		void arm( bool on );
+		void report( uint32_t id, const char* event );
+		void check( uint32_t id, uint8_t edge );
+		void step();
+
+	public:
+		Daemon() : mEpoll( -1 ), mTimer( -1 ), mMillisPerTick( Button::MS_PER_TICK ),
+			mRunning( false ), mTick( 0 ) {}
+
+		bool init( const char* socketPath, uint8_t ms, uint32_t inputs );
+		uint32_t addChannels( uint32_t n );
+		uint32_t channels() const { return mChannels.size(); }
+		bool watch( int fd, Pollable* p, uint32_t events = EPOLLIN );
+		void unwatch( int fd ) { epoll_ctl( mEpoll, EPOLL_CTL_DEL, fd, NULL ); }
+
+		void sample( uint32_t id, uint8_t level );
+		void onEvent( uint32_t events ) override;
+		void run();
+};
+
+
+// ----------------------------------------------------------------------------
+// ----- Publisher
+
+bool Publisher::open( int epoll, const char* path )
+{
+	struct sockaddr_un addr;
+
+	mEpoll = epoll;
+	if (strlen( path ) >= sizeof(addr.sun_path)) {
+		fprintf( stderr, "socket path too long: %s\n", path );
+		return false;
+	}
+	mFd = socket( AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+	if (mFd < 0) { perror( "socket" ); return false; }
+	memset( &addr, 0, sizeof(addr) );
+	addr.sun_family = AF_UNIX;
+	strcpy( addr.sun_path, path );
+	unlink( path );
+	if (bind( mFd, (struct sockaddr*)&addr, sizeof(addr) ) < 0 || listen( mFd, 16 ) < 0) {
+		perror( path );
+		return false;
+	}
+	struct epoll_event ev = { EPOLLIN, { this } };
+	return epoll_ctl( mEpoll, EPOLL_CTL_ADD, mFd, &ev ) == 0;
+}
+
+
+/// @brief New client
+void Publisher::onEvent( uint32_t )
+{
+	int fd = accept4( mFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC );
+	if (fd < 0) return;
+	Client* c = new Client( *this, fd );
+	struct epoll_event ev = { EPOLLIN | EPOLLRDHUP, { c } };
+	epoll_ctl( mEpoll, EPOLL_CTL_ADD, fd, &ev );
+	mClients.push_back( c );
+}
+
+
+/// @brief Client can take more data, sent something, or hung up: ignore data, drop on hangup
+void Publisher::Client::onEvent( uint32_t events )
+{
+	if (events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+		mOwner.drop( this );
+		return;
+	}
+	if (events & EPOLLIN) {
+		char buf[64];
+		while (read( mFd, buf, sizeof(buf) ) > 0) ;
+	}
+	if (events & EPOLLOUT) send();
+}
+
+
+/// @brief Send as much as the socket takes, wait for EPOLLOUT if there is more
+void Publisher::Client::send()
+{
+	ssize_t n = ::send( mFd, mOut.data(), mOut.size(), MSG_DONTWAIT | MSG_NOSIGNAL );
+	if (n > 0) mOut.erase( 0, n );
+	bool wait = !mOut.empty();
+	if (wait != mWaiting) {
+		struct epoll_event ev = { EPOLLIN | EPOLLRDHUP | (wait ? EPOLLOUT : 0u), { this } };
+		epoll_ctl( mOwner.mEpoll, EPOLL_CTL_MOD, mFd, &ev );
+		mWaiting = wait;
+	}
+}
+
+
+void Publisher::drop( Client* c )
+{
+	for (size_t i=0; i<mClients.size(); i++) {
+		if (mClients[i] == c) {
+			mClients[i] = mClients.back();
+			mClients.pop_back();
+			break;
+		}
+	}
+	epoll_ctl( mEpoll, EPOLL_CTL_DEL, c->mFd, NULL );
+	close( c->mFd );
+	delete c;
+}
+
+
+/// @brief Queue line for all clients, drop it for clients that are too far behind
+void Publisher::publish( const char* line, size_t len )
+{
+	for (Client* c : mClients)
+		if (c->mOut.size() + len <= MAX_BUFFERED)
+			c->mOut.append( line, len );
+}
+
+
+/**
+ * @brief Send queued lines, never blocks.
+ * A client that has gone away is dropped by its own EPOLLRDHUP event, not here,
+ * so that no pending epoll event can refer to a deleted client.
+ */
+void Publisher::flush()
+{
+	for (Client* c : mClients)
+		if (!c->mOut.empty() && !c->mWaiting) c->send();
+}
+
+
+// ----------------------------------------------------------------------------
+// ----- Daemon
+
+bool Daemon::init( const char* socketPath, uint8_t ms, uint32_t inputs )
+{
+	mMillisPerTick = ms;
+	clock_gettime( CLOCK_MONOTONIC, &mStart );
+	mEpoll = epoll_create1( EPOLL_CLOEXEC );
+	mTimer = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+	if (mEpoll < 0 || mTimer < 0) { perror( "epoll/timerfd" ); return false; }
+	addChannels( inputs );
+	return watch( mTimer, this ) && mPublisher.open( mEpoll, socketPath );
+}
+
+
+/// @brief Add `n` channels, return id of the first one
+uint32_t Daemon::addChannels( uint32_t n )
+{
+	uint32_t first = mChannels.size();
+	mChannels.resize( first + n );
+	for (uint32_t i=first; i<first+n; i++) {
+		Channel& c = mChannels[i];
+		c.button.init();
+		c.button.setMillisPerTick( mMillisPerTick );
+		c.level = 0;
+		c.active = false;
+		c.lastTick = mTick;
+	}
+	return first;
+}
+
+
+bool Daemon::watch( int fd, Pollable* p, uint32_t events )
+{
+	struct epoll_event ev = { events, { p } };
+	if (epoll_ctl( mEpoll, EPOLL_CTL_ADD, fd, &ev ) < 0) {
+		perror( "epoll_ctl" );
+		return false;
+	}
+	return true;
+}
+
+
+/// @brief # of ticks since start, from the monotonic clock
+uint32_t Daemon::currentTick() const
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	int64_t ms = (int64_t)(now.tv_sec - mStart.tv_sec) * 1000 + (now.tv_nsec - mStart.tv_nsec) / 1000000;
+	return (uint32_t)(ms / mMillisPerTick);
+}
+
+
+/// @brief Start the tick timer at the next tick boundary, or stop it
+void Daemon::arm( bool on )
+{
+	struct itimerspec its;
+	memset( &its, 0, sizeof(its) );
+	if (on) {
+		uint64_t ns = (uint64_t)(currentTick() + 1) * mMillisPerTick * 1000000
+					+ (uint64_t)mStart.tv_sec * 1000000000 + mStart.tv_nsec;
+		its.it_value.tv_sec = ns / 1000000000;
+		its.it_value.tv_nsec = ns % 1000000000;
+		its.it_interval.tv_nsec = (long)mMillisPerTick * 1000000;
+	}
+	timerfd_settime( mTimer, on ? TFD_TIMER_ABSTIME : 0, &its, NULL );
+	mRunning = on;
+}
+
+
+void Daemon::report( uint32_t id, const char* event )
+{
+	char line[32];
+	int n = snprintf( line, sizeof(line), "%u %s\n", id, event );
+	mPublisher.publish( line, n );
+}
+
+
+/// @brief Report edge and gestures of channel `id`, consume its gesture counters
+void Daemon::check( uint32_t id, uint8_t edge )
+{
+	ButtonCore& b = mChannels[id].button;
+
+	if (edge == Debounce::PRESS) report( id, "press" );
+	else if (edge == Debounce::RELEASE) report( id, "release" );
+	if (b.cShortPress)	{ b.cShortPress = 0;	report( id, "short" ); }
+	if (b.cLongPress)	{ b.cLongPress = 0;		report( id, "long" ); }
+	if (b.cDoublePress)	{ b.cDoublePress = 0;	report( id, "double" ); }
+}
+
+
+/**
+ * @brief Level of input `id` has changed, called by the input backends.
+ * An inactive channel is first brought up to date, then ticked from the next tick on.
+ */
+void Daemon::sample( uint32_t id, uint8_t level )
+{
+	if (id >= mChannels.size()) return;
+	Channel& c = mChannels[id];
+
+	c.level = level ? 1 : 0;
+	if (c.active) return;
+	if (!mRunning) {
+		// no channel was active, so nothing to do for the ticks in between
+		mTick = currentTick();
+		arm( true );
+	}
+	uint32_t gap = mTick - c.lastTick;
+	if (gap > UINT32_MAX / mMillisPerTick) gap = UINT32_MAX / mMillisPerTick;
+	c.button.skipMillis( gap * mMillisPerTick );
+	check( id, Debounce::NONE );
+	c.active = true;
+	mActive.push_back( id );
+}
+
+
+/// @brief One tick for all active channels, retire those that are quiet
+void Daemon::step()
+{
+	mTick++;
+	size_t k = 0;
+	for (size_t i=0; i<mActive.size(); i++) {
+		uint32_t id = mActive[i];
+		Channel& c = mChannels[id];
+		check( id, c.button.tickInline( c.level ) );
+		if (c.button.nextWakeupTicks() == Contact::NO_WAKEUP) {
+			c.active = false;
+			c.lastTick = mTick;
+		} else {
+			mActive[k++] = id;
+		}
+	}
+	mActive.resize( k );
+}
+
+
+/// @brief Timer expired, once or several times
+void Daemon::onEvent( uint32_t )
+{
+	uint64_t n;
+	if (read( mTimer, &n, sizeof(n) ) != sizeof(n)) return;
+	while (n-- && !mActive.empty())
+		step();
+	if (mActive.empty()) arm( false );
+}
+
+
+void Daemon::run()
+{
+	struct epoll_event events[64];
+
+	for (;;) {
+		int n = epoll_wait( mEpoll, events, 64, -1 );
+		if (n < 0 && errno != EINTR) { perror( "epoll_wait" ); return; }
+		for (int i=0; i<n; i++)
+			((Pollable*)events[i].data.ptr)->onEvent( events[i].events );
+		mPublisher.flush();
+	}
+}
+
+
+// ----------------------------------------------------------------------------
+// ----- input backends
+
+/// @brief Lines "<id> <level>" from a pipe, FIFO or serial port
+class LineInput : public Input {
+	private:
+		std::string		mBuf;
+		bool			mKeepOpen;
+
+	public:
+		LineInput( Daemon& d ) : Input( d ), mKeepOpen( false ) {}
+
+		/// open a FIFO (kept open, so writers can come and go), or stdin for "-"
+		bool open( const char* path ) {
+			if (strcmp( path, "-" ) == 0) {
+				mFd = dup( 0 );
+				fcntl( mFd, F_SETFL, O_NONBLOCK );
+			} else {
+				// O_RDWR: no EOF when the last writer closes
+				mFd = ::open( path, O_RDWR | O_NONBLOCK | O_CLOEXEC );
+				mKeepOpen = true;
+			}
+			if (mFd < 0) { perror( path ); return false; }
+			return mDaemon.watch( mFd, this );
+		}
+
+		void onEvent( uint32_t ) override {
+			char buf[4096];
+			ssize_t n;
+			while ((n = read( mFd, buf, sizeof(buf) )) > 0) {
+				mBuf.append( buf, n );
+				size_t start = 0, end;
+				while ((end = mBuf.find( '\n', start )) != std::string::npos) {
+					// parse this line only, %u would skip the newline and take the next one
+					std::string line( mBuf, start, end - start );
+					unsigned id, level;
+					char extra;
+					if (sscanf( line.c_str(), "%u %u %c", &id, &level, &extra ) == 2)
+						mDaemon.sample( id, level );
+					start = end + 1;
+				}
+				mBuf.erase( 0, start );
+			}
+			if (n == 0 && !mKeepOpen) {
+				// EOF on stdin or pipe
+				mDaemon.unwatch( mFd );
+				close( mFd );
+				mFd = -1;
+			}
+		}
+};
+
+
+/// @brief Same line format, from a serial port
+class SerialInput : public LineInput {
+	public:
+		SerialInput( Daemon& d ) : LineInput( d ) {}
+
+		bool open( const char* spec ) {
+			std::string dev( spec );
+			speed_t speed = B115200;
+			size_t colon = dev.find( ':' );
+			if (colon != std::string::npos) {
+				switch (atoi( dev.c_str() + colon + 1 )) {
+					case 9600:		speed = B9600;		break;
+					case 19200:		speed = B19200;		break;
+					case 38400:		speed = B38400;		break;
+					case 57600:		speed = B57600;		break;
+					case 115200:	speed = B115200;	break;
+					default:
+						fprintf( stderr, "unsupported baud rate: %s\n", spec );
+						return false;
+				}
+				dev.resize( colon );
+			}
+			mFd = ::open( dev.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC );
+			if (mFd < 0) { perror( dev.c_str() ); return false; }
+			struct termios tio;
+			if (tcgetattr( mFd, &tio ) == 0) {
+				cfmakeraw( &tio );
+				cfsetspeed( &tio, speed );
+				tio.c_cflag |= CLOCAL | CREAD;
+				tcsetattr( mFd, TCSANOW, &tio );
+			}
+			return mDaemon.watch( mFd, this );
+		}
+};
+
+
+/// @brief Lines of a GPIO character device, with edge events
+class GpioInput : public Input {
+	private:
+		uint32_t	mFirst;						// channel id of first line
+		uint32_t	mOffsets[GPIO_V2_LINES_MAX];
+		uint32_t	mCount;
+
+	public:
+		GpioInput( Daemon& d ) : Input( d ), mFirst( 0 ), mCount( 0 ) {}
+
+		/// `spec` is "chip:offset,offset,...[:low]", "low" for active-low contacts
+		bool open( const char* spec ) {
+			std::string s( spec );
+			size_t c1 = s.find( ':' );
+			if (c1 == std::string::npos) { fprintf( stderr, "bad GPIO spec: %s\n", spec ); return false; }
+			std::string chip = s.substr( 0, c1 );
+			size_t c2 = s.find( ':', c1+1 );
+			bool activeLow = (c2 != std::string::npos) && s.compare( c2+1, std::string::npos, "low" ) == 0;
+
+			struct gpio_v2_line_request req;
+			memset( &req, 0, sizeof(req) );
+			const char* p = s.c_str() + c1 + 1;
+			while (*p && *p != ':' && mCount < GPIO_V2_LINES_MAX) {
+				char* end;
+				mOffsets[mCount] = req.offsets[mCount] = strtoul( p, &end, 10 );
+				mCount++;
+				p = (*end == ',') ? end+1 : end;
+			}
+			req.num_lines = mCount;
+			strcpy( req.consumer, "buttond" );
+			req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING
+							 | GPIO_V2_LINE_FLAG_EDGE_FALLING | (activeLow ? GPIO_V2_LINE_FLAG_ACTIVE_LOW : 0);
+
+			int chipFd = ::open( chip.c_str(), O_RDONLY | O_CLOEXEC );
+			if (chipFd < 0) { perror( chip.c_str() ); return false; }
+			int rc = ioctl( chipFd, GPIO_V2_GET_LINE_IOCTL, &req );
+			close( chipFd );
+			if (rc < 0) { perror( "GPIO_V2_GET_LINE_IOCTL" ); return false; }
+			mFd = req.fd;
+			fcntl( mFd, F_SETFL, O_NONBLOCK );
+			mFirst = mDaemon.addChannels( mCount );
+			for (uint32_t i=0; i<mCount; i++)
+				fprintf( stderr, "%s line %u = input %u\n", chip.c_str(), mOffsets[i], mFirst+i );
+
+			// initial levels
+			struct gpio_v2_line_values v;
+			v.mask = (mCount < 64) ? ((uint64_t)1 << mCount) - 1 : ~(uint64_t)0;
+			if (ioctl( mFd, GPIO_V2_LINE_GET_VALUES_IOCTL, &v ) == 0)
+				for (uint32_t i=0; i<mCount; i++)
+					mDaemon.sample( mFirst+i, (v.bits >> i) & 1 );
+			return mDaemon.watch( mFd, this );
+		}
+
+		void onEvent( uint32_t ) override {
+			struct gpio_v2_line_event ev[16];
+			ssize_t n;
+			while ((n = read( mFd, ev, sizeof(ev) )) > 0) {
+				for (size_t k=0; k < n / sizeof(ev[0]); k++)
+					for (uint32_t i=0; i<mCount; i++)
+						if (mOffsets[i] == ev[k].offset)
+							mDaemon.sample( mFirst+i, ev[k].id == GPIO_V2_LINE_EVENT_RISING_EDGE );
+			}
+		}
+};
+
+
+// ----------------------------------------------------------------------------
+
+static void usage()
+{
+	fprintf( stderr,
+		"usage: buttond [-s socket] [-t ms_per_tick] [-n inputs] input...\n"
+		"  -f path               named pipe, or - for stdin: lines \"<id> <level>\"\n"
+		"  -d tty[:baud]         serial port, same line format\n"
+		"  -g chip:off,..[:low]  GPIO character device lines, ids follow the -n range\n" );
+	exit( 1 );
+}
+
+
+int main( int argc, char* argv[] )
+{
+	const char* socketPath = "/tmp/buttond.sock";
+	int ms = Button::MS_PER_TICK;
+	uint32_t inputs = 1024;
+	int opt;
+
+	// first pass: options that the inputs depend on
+	while ((opt = getopt( argc, argv, "s:t:n:f:d:g:" )) != -1) {
+		switch (opt) {
+			case 's':	socketPath = optarg;	break;
+			case 't':	ms = atoi( optarg );	break;
+			case 'n':	inputs = strtoul( optarg, NULL, 10 );	break;
+			case 'f': case 'd': case 'g':	break;
+			default:	usage();
+		}
+	}
+	if (ms < 1 || ms > 255) usage();
+	signal( SIGPIPE, SIG_IGN );
+
+	static Daemon daemon;
+	if (!daemon.init( socketPath, ms, inputs )) return 1;
+
+	optind = 1;
+	int nInputs = 0;
+	while ((opt = getopt( argc, argv, "s:t:n:f:d:g:" )) != -1) {
+		bool ok = true;
+		switch (opt) {
+			case 'f':	ok = (new LineInput( daemon ))->open( optarg );		nInputs++;	break;
+			case 'd':	ok = (new SerialInput( daemon ))->open( optarg );	nInputs++;	break;
+			case 'g':	ok = (new GpioInput( daemon ))->open( optarg );		nInputs++;	break;
+		}
+		if (!ok) return 1;
+	}
+	if (!nInputs) usage();
+
+	fprintf( stderr, "buttond: %u inputs, %d ms per tick, socket %s\n", daemon.channels(), ms, socketPath );
+	daemon.run();
+	return 1;
+}
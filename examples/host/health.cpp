@@ -0,0 +1,146 @@
+/**
+ * @file 		  health.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Check `ContactHealth` with exact bounces, and with simulated wear.
+ *
+ * - settle: presses and releases that bounce for exactly k ticks, for k going down,
+ *   then up. The averages must settle within 2^(SHIFT-1) LSB of k and k+1 edges,
+ *   from either side.
+ * - wear: `Waveform` signals of a contact that gets worse in stages: more and longer
+ *   bounces, then dropouts while held (EMI spikes). `needsService` must stay clear
+ *   for a new and a used contact and be set for a worn one, the mean bounce average
+ *   must grow, and the spikes must raise the mean dropout average of a new contact.
+ *
+ * usage: health [presses] [seed]
+ * Exit code is 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Button.h>
+#include <ButtonHealth.h>
+#include "Waveform.h"
+
+static ButtonCore button;
+static ContactHealth health;
+
+
+static void feed( uint8_t level )
+{
+	health.tick( button.tickInline( level ), button );
+}
+
+
+/// an edge to `level` that bounces for `k` ticks (k even), then holds
+static void edge( uint8_t level, uint8_t k, uint8_t hold )
+{
+	for (uint8_t i=0; i<k; i++) feed( (i & 1) ? !level : level );
+	for (uint8_t i=0; i<hold; i++) feed( level );
+}
+
+
+/// @return # of failed checks
+static unsigned settle( unsigned presses )
+{
+	const uint8_t stages[] = { 6, 2, 4, 0, 2 };
+	const int tolerance = 1 << (BUTTON_HEALTH_SHIFT-1);
+	unsigned bad = 0;
+
+	for (uint8_t k : stages) {
+		for (unsigned p=0; p<presses; p++) {
+			edge( 1, k, 30 );
+			edge( 0, k, 30 );
+		}
+		int db = (int)health.bounceAvg - 16*k;
+		int de = (int)health.edgesAvg - 16*(k+1);
+		bool ok = abs( db ) <= tolerance && abs( de ) <= tolerance;
+		printf( "settle: bounce %d ticks: average %.3f, edges %.3f for %d, %s\n",
+			k, health.bounceAvg / 16.0, health.edgesAvg / 16.0, k+1, ok ? "ok" : "NOT SETTLED" );
+		if (!ok) bad++;
+	}
+	return bad;
+}
+
+
+/// @return # of failed checks
+static unsigned wear( unsigned presses, uint64_t seed )
+{
+	struct Stage {
+		const char*		name;
+		double			bounces;
+		double			bounceMs;
+		double			spikeRate;
+		bool			service;		// needsService expected
+	};
+	// the bounce gets worse, then a new contact that drops out while held
+	const Stage stages[] = {
+		{ "new",		0.5,	0.2,	0,		false },
+		{ "used",		1,		0.4,	0,		false },
+		{ "worn",		6,		1.5,	0,		true },
+		{ "dropouts",	0.5,	0.2,	5,		true },
+	};
+	unsigned bad = 0;
+	double lastBounce = 0, newDropout = 0;
+
+	for (const Stage& s : stages) {
+		WaveformParams p;
+		p.bounces = s.bounces;
+		p.bounceMs = s.bounceMs;
+		p.spikeRate = s.spikeRate;
+		p.spikeMs = 2;
+		Waveform w( seed );
+		w.generate( p, presses );
+
+		health.init();
+		button.init();
+		// the averages follow single presses, so compare their means over the stage
+		double bounce = 0, dropout = 0;
+		unsigned long n = 0;
+		for (uint64_t t=0; t<w.end(); t+=1000, n++) {
+			feed( w.at( t ) );
+			bounce += health.bounceAvg;
+			dropout += health.dropoutAvg;
+		}
+		bounce /= 16.0 * n;
+		dropout /= 16.0 * n;
+
+		bool ok = (health.needsService == s.service)
+			&& (s.spikeRate ? dropout > newDropout : bounce >= lastBounce);
+		printf( "wear %-10s mean bounce %5.2f ticks, dropouts %4.2f/press, service %d, %s\n",
+			s.name, bounce, dropout, (int)health.needsService, ok ? "ok" : "UNEXPECTED" );
+		if (!ok) bad++;
+		// bounces while held count as dropouts too, so compare with the new contact
+		if (&s == stages) newDropout = dropout;
+		if (!s.spikeRate) lastBounce = bounce;
+	}
+	return bad;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	unsigned presses = (argc > 1) ? atoi( argv[1] ) : 2000;
+	uint64_t seed = (argc > 2) ? atol( argv[2] ) : 1;
+
+	printf( "BUTTON_NTICKS=%d, BUTTON_HEALTH_SHIFT=%d, 1 ms per tick\n", BUTTON_NTICKS, BUTTON_HEALTH_SHIFT );
+	unsigned bad = settle( 200 );
+	bad += wear( presses, seed );
+	return bad ? 1 : 0;
+}
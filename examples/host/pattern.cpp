@@ -0,0 +1,217 @@
+/**
+ * @file 		  pattern.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Check `PatternMatcher` on a `ButtonCore`, with codes that overlap.
+ *
+ * Codes: "..-", "-.-.", ".", "..-." and "---". "." is a prefix of "..-", which is a
+ * prefix of "..-.", so those wait for the pause before they are reported.
+ * - cases: fixed input sequences, with the codes expected and when: at the last
+ *   release, or only after BUTTON_PATTERN_GAP ms without a press. They cover pauses
+ *   just below and above the gap between symbols, wrong symbols, presses after a wrong
+ *   symbol, and a press after a complete code, which starts the next code.
+ * - random: random symbols and pauses, against a reference model working on strings.
+ *   Press durations and pauses keep 100 ms away from the dash and gap limits.
+ *
+ * usage: pattern [symbols] [seed]
+ * Exit code is 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <Button.h>
+#include <ButtonPattern.h>
+
+static const char* const codes[] = { "..-", "-.-.", ".", "..-.", "---" };
+#define NCODES	(sizeof(codes) / sizeof(codes[0]))
+
+typedef ButtonPatterns< patternCode("..-"), patternCode("-.-."), patternCode("."),
+	patternCode("..-."), patternCode("---") > Codes;
+
+static ButtonCore button;
+static PatternMatcher matcher( Codes::table(), Codes::SIZE );
+static uint32_t now;							// ms
+static std::vector<uint8_t> matches;			// codes reported so far
+static std::vector<uint32_t> matchTimes;		// when, in ms
+
+
+/// `ticks` ticks of `level`, collect the codes reported
+static void feed( uint8_t level, uint32_t ms )
+{
+	for (uint32_t t=0; t<ms; t+=Button::MS_PER_TICK) {
+		now += Button::MS_PER_TICK;
+		matcher.tick( button.tickInline( level ), button );
+		if (matcher.match) {
+			matches.push_back( (uint8_t)matcher.match );
+			matchTimes.push_back( now );
+			matcher.match = 0;
+		}
+	}
+}
+
+
+/// one symbol: a press of `pressMs`, then a pause of `gapMs`
+static void symbol( uint32_t pressMs, uint32_t gapMs )
+{
+	feed( 1, pressMs );
+	feed( 0, gapMs );
+}
+
+
+static void reset()
+{
+	button.init();
+	matcher.init( Codes::table(), Codes::SIZE );
+	now = 0;
+	feed( 0, 100 );
+	matches.clear();
+	matchTimes.clear();
+}
+
+
+struct Case {
+	const char*		name;
+	const char*		input;		///< '.' and '-' are presses, ' ' is a pause of 900 ms, '|' one of 1100 ms
+	const char*		expected;	///< codes reported, 1-based, e.g. "34"
+	bool			atRelease;	///< the last code is reported within a few ticks of its release
+};
+
+
+/// @return # of failed cases
+static unsigned cases()
+{
+	const Case list[] = {
+		{ "complete code",				"-.-.",		"2",	true },
+		{ "prefix waits for gap",		"..-",		"1",	false },
+		{ "longest code",				"..-.",		"4",	true },
+		{ "shortest code",				".",		"3",	false },
+		{ "pause below gap",			". .-",		"1",	false },
+		{ "pause above gap",			".|..-.",	"34",	true },
+		{ "two codes",					"---|-.-.",	"52",	true },
+		{ "wrong symbol",				"-..",		"",		false },
+		{ "presses after wrong",		"-.....-.",	"",		false },
+		{ "code after wrong",			"-..|---",	"5",	true },
+		{ "wrong after prefix",			"--.",		"",		false },
+		{ "complete code, then next",	"..-..",	"43",	false },
+	};
+	unsigned bad = 0;
+
+	for (const Case& c : list) {
+		reset();
+		uint32_t lastRelease = 0;
+		for (const char* p = c.input; *p; p++) {
+			if (*p == ' ' || *p == '|') continue;
+			char next = p[1];
+			uint32_t gap = (next == ' ') ? 900 : (next == '|') ? 1100 : 200;
+			feed( 1, (*p == '-') ? 600 : 150 );
+			lastRelease = now;
+			feed( 0, gap );
+		}
+		feed( 0, 2 * PatternMatcher::GAP_MS );
+
+		std::string got;
+		for (uint8_t m : matches) got += (char)('0' + m);
+		bool ok = got == c.expected;
+		if (ok && !matches.empty()) {
+			// reported a few ticks after the debounced release, or after the gap
+			uint32_t delay = matchTimes.back() - lastRelease;
+			uint32_t quick = (BUTTON_NTICKS + 2) * Button::MS_PER_TICK;
+			ok = c.atRelease ? (delay <= quick) : (delay > PatternMatcher::GAP_MS);
+		}
+		printf( "cases: %-26s \"%s\": got \"%s\", expected \"%s\"%s, %s\n", c.name, c.input,
+			got.c_str(), c.expected, c.atRelease ? " at release" : " after gap", ok ? "ok" : "WRONG" );
+		if (!ok) bad++;
+	}
+	return bad;
+}
+
+
+/// @return true if `s` is a code, with its 1-based index in `index`
+static bool isCode( const std::string& s, uint8_t& index )
+{
+	for (uint8_t i=0; i<NCODES; i++)
+		if (s == codes[i]) { index = i+1; return true; }
+	return false;
+}
+
+
+/// @return true if `s` is a proper prefix of a code
+static bool isPrefix( const std::string& s )
+{
+	for (const char* c : codes)
+		if (strlen( c ) > s.size() && strncmp( c, s.c_str(), s.size() ) == 0) return true;
+	return false;
+}
+
+
+/// @return # of differences between the matcher and the model
+static unsigned random( unsigned long n )
+{
+	std::vector<uint8_t> expected;
+	std::string cur;
+	bool dead = false;
+	uint8_t index;
+
+	reset();
+	for (unsigned long k=0; k<n; k++) {
+		bool dash = rand() % 2;
+		bool pause = rand() % 3 == 0;
+		uint32_t pressMs = dash ? 500 + rand() % 1000 : 50 + rand() % 250;
+		uint32_t gapMs = pause ? 1100 + rand() % 2000 : 50 + rand() % 850;
+		symbol( pressMs, gapMs );
+
+		// model: each release adds a symbol, a pause ends the code
+		if (!dead) {
+			cur += dash ? '-' : '.';
+			if (isPrefix( cur )) {
+				// wait for more
+			} else if (isCode( cur, index )) {
+				expected.push_back( index );
+				cur.clear();
+			} else {
+				dead = true;
+			}
+		}
+		if (pause) {
+			if (!dead && isCode( cur, index )) expected.push_back( index );
+			cur.clear();
+			dead = false;
+		}
+	}
+
+	unsigned bad = (matches != expected) ? 1 : 0;
+	printf( "random: %lu symbols, %zu codes reported, %zu expected, %s\n",
+		n, matches.size(), expected.size(), bad ? "WRONG" : "ok" );
+	return bad;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	unsigned long n = (argc > 1) ? atol( argv[1] ) : 100000;
+	srand( (argc > 2) ? atoi( argv[2] ) : 3 );
+
+	printf( "dash from %u ms, gap %u ms, %u states\n", PatternMatcher::DASH_MS, PatternMatcher::GAP_MS, Codes::SIZE );
+	unsigned bad = cases();
+	bad += random( n );
+	return bad ? 1 : 0;
+}
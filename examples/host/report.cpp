@@ -0,0 +1,151 @@
+/**
+ * @file 		  report.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Check `ButtonReporter` over one hour of simulated time, in 1 ms steps.
+ *
+ * - rate: random events of 16 buttons, one every 200 ms on average, long presses
+ *   as priority events. No events may be lost or invented, and reports must keep
+ *   `minGapMs`, or `minPriorityGapMs` for priority reports.
+ * - state: the reporter is reused via `init()`, and fed only the gestures of 16
+ *   `Button`s with random presses, via `buttonEvents`. Each report must carry the
+ *   state of its button when the summary started.
+ *
+ * usage: report [seed]
+ * Exit code is 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Button.h>
+#include <ButtonReport.h>
+
+#define HOUR_MS		3600000ul
+#define NBUTTONS	16
+
+static ButtonReporter reporter( 500, 2000 );
+static Button buttons[NBUTTONS];
+
+
+/// @return # of failed checks
+static unsigned long rate()
+{
+	unsigned long posted[BUTTON_EVENT_KINDS] = { 0 }, got[BUTTON_EVENT_KINDS] = { 0 };
+	unsigned long reports = 0, urgent = 0, gapViolations = 0, maxLatency = 0;
+	uint32_t last = 0;
+	bool had = false;
+	ButtonReport r;
+
+	reporter.minPriorityGapMs = 100;
+	reporter.priority = BUTTON_EVENT_BIT(TRACE_LONG);
+
+	for (uint32_t t=0; t<HOUR_MS; t++) {
+		if (rand() % 200 == 0) {
+			uint8_t ev = rand() % BUTTON_EVENT_KINDS;
+			if (ev == TRACE_LONG && rand() % 10) ev = TRACE_SHORT;
+			reporter.post( ev, rand() % NBUTTONS, t );
+			posted[ev]++;
+		}
+		if (t % 10) continue;
+		while (reporter.poll( r, t )) {
+			bool p = r.count[TRACE_LONG] != 0;
+			reports++;
+			if (p) urgent++;
+			for (uint8_t k=0; k<BUTTON_EVENT_KINDS; k++) got[k] += r.count[k];
+			if (had && t - last < (p ? reporter.minPriorityGapMs : reporter.minGapMs)) gapViolations++;
+			if (t - r.first > maxLatency) maxLatency = t - r.first;
+			last = t;
+			had = true;
+		}
+	}
+	// drain the rest
+	for (uint32_t t=HOUR_MS; reporter.busy(); t+=reporter.minGapMs)
+		while (reporter.poll( r, t ))
+			for (uint8_t k=0; k<BUTTON_EVENT_KINDS; k++) got[k] += r.count[k];
+
+	unsigned long bad = gapViolations, events = 0;
+	for (uint8_t k=0; k<BUTTON_EVENT_KINDS; k++) {
+		// counts saturate at 255 per summary, none gets near that here
+		if (got[k] != posted[k]) bad++;
+		events += posted[k];
+	}
+	printf( "rate: %lu events in %lu reports (%lu priority), %.1f events per report, "
+			"max. latency %lu ms, %lu gap violations, %s\n",
+		events, reports, urgent, (double)events / reports, maxLatency, gapViolations,
+		(bad == gapViolations) ? "no events lost" : "EVENTS LOST" );
+	return bad;
+}
+
+
+static bool opened[NBUTTONS];		// summary started, by our own bookkeeping
+static uint8_t expected[NBUTTONS];	// state of the button when it started
+static uint32_t now;
+
+static void onGesture( uint8_t event, uint8_t button )
+{
+	if (!opened[button]) {
+		opened[button] = true;
+		expected[button] = buttons[button].isDown;
+	}
+	reporter.post( event, button, now );
+}
+
+
+/// @return # of reports with the wrong state
+static unsigned long state()
+{
+	uint8_t level[NBUTTONS] = { 0 };
+	uint16_t run[NBUTTONS] = { 0 };
+	unsigned long reports = 0, wrong = 0;
+	ButtonReport r;
+
+	reporter.init( 500, 2000 );
+	for (uint8_t i=0; i<NBUTTONS; i++) buttonEvents.add( &buttons[i] );
+	buttonEvents.subscribe( onGesture, BUTTON_GESTURES, (ButtonMask)~0 );
+
+	for (now=0; now<HOUR_MS; now++) {
+		if (now % Button::MS_PER_TICK) continue;
+		for (uint8_t i=0; i<NBUTTONS; i++) {
+			if (run[i] == 0) {
+				level[i] = !level[i];
+				run[i] = level[i] ? 2 + rand() % 150 : 5 + rand() % 60;
+			}
+			run[i]--;
+			buttons[i].tick( level[i] );
+		}
+		buttonEvents.dispatch();
+		while (reporter.poll( r, now )) {
+			reports++;
+			if (r.isDown != expected[r.button]) wrong++;
+			opened[r.button] = false;
+		}
+	}
+	printf( "state: %lu reports, %lu with the wrong state, %u events dropped\n",
+		reports, wrong, buttonEvents.cDropped );
+	return wrong;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	srand( (argc > 1) ? atoi( argv[1] ) : 9 );
+	unsigned long bad = rate();
+	bad += state();
+	return bad ? 1 : 0;
+}
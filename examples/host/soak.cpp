@@ -0,0 +1,215 @@
+/**
+ * @file 		  soak.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Soak test of `Button` gesture timing over very long uptimes.
+ *
+ * Two parts:
+ * - model: random presses, bounces and idle times are fed to a `Button` and to a
+ *   reference model of the same gestures with 64-bit time, which cannot wrap.
+ *   Idle times are passed in accelerated time via `skipMillis()`, some of them
+ *   close to multiples of 2^32 ms, so billions of ticks are covered in seconds.
+ *   Counters, `isDown` and `holdTime` must match after every segment.
+ * - wrap: a short press, then ~2^32 ms of real ticks released, then another
+ *   short press, which must not be a double press.
+ *
+ * usage: soak [segments] [wraps]
+ * Exit code is 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <Button.h>
+
+/// Gestures of `Button`, with 64-bit timestamps in ms
+struct Model {
+	uint8_t		state = 0;
+	bool		down = false;
+	bool		pending = false;
+	uint64_t	now = 0;
+	uint64_t	pressedAt = 0;
+	uint64_t	releasedAt = 0;
+	bool		released = false;	// releasedAt is valid
+	uint16_t	holdTime = 0;
+	uint64_t	cPressed = 0, cShort = 0, cLong = 0, cDouble = 0;
+
+	void tick( uint8_t level ) {
+		now += Button::MS_PER_TICK;
+		state = (uint8_t)(state << 1) | level;
+		if ((state & Debounce::MASK) == Debounce::RISE) {
+			cPressed++;
+			down = true;
+			holdTime = 0;
+			pending = false;
+			pressedAt = now;
+		} else if ((state & Debounce::MASK) == Debounce::FALL) {
+			down = false;
+			if (holdTime > Button::longPressMs) cLong++;
+			else if (released && pressedAt - releasedAt < Button::doublePressMs) cDouble++;
+			else pending = true;
+			releasedAt = now;
+			released = true;
+		}
+		if (down && holdTime < UINT16_MAX - Button::MS_PER_TICK) holdTime += Button::MS_PER_TICK;
+		expire();
+	}
+
+	/// `ticks` ticks without an input change
+	void skip( uint64_t ticks ) {
+		now += ticks * Button::MS_PER_TICK;
+		for ( ; down && ticks && holdTime < UINT16_MAX - Button::MS_PER_TICK; ticks--)
+			holdTime += Button::MS_PER_TICK;
+		expire();
+	}
+
+	void expire() {
+		if (pending && now - releasedAt > Button::doublePressMs) {
+			pending = false;
+			cShort++;
+		}
+	}
+};
+
+
+/// Counters of a `Button`, extended to 64 bits. They saturate at 255, so they are
+/// moved to the totals after each segment.
+struct Counts {
+	uint64_t	total[4] = {};
+
+	void update( Button& b ) {
+		total[0] += b.cPressed;
+		total[1] += b.cShortPress;
+		total[2] += b.cLongPress;
+		total[3] += b.cDoublePress;
+		b.cPressed = b.cShortPress = b.cLongPress = b.cDoublePress = 0;
+	}
+};
+
+
+static Button button;
+
+
+/// @return # of segments where `Button` and the model disagreed
+static unsigned long model( unsigned long segments, uint64_t& ticks )
+{
+	Model m;
+	Counts c;
+	unsigned long bad = 0;
+	uint8_t level = 0;
+
+	for (unsigned long seg=0; seg<segments; seg++) {
+		// a bounce, a short run or a long run
+		level = !level;
+		int r = rand() % 100;
+		int run = (r < 20) ? 1 + rand() % 3 : (r < 60) ? 5 + rand() % 30 : 50 + rand() % 150;
+		for (int j=0; j<run; j++) {
+			m.tick( level );
+			button.tick( level );
+		}
+		ticks += run;
+
+		if (level == 0 && rand() % 20 == 0) {
+			// long idle time, in accelerated time; some close to multiples of 2^32 ms
+			uint64_t gap = (rand() % 3 == 0)
+				? (1ull << 32) / Button::MS_PER_TICK * (1 + rand() % 3) + rand() % 41 - 20
+				: (uint64_t)(rand() % 100000) * 1000;
+			for (int j=0; j<5; j++) {
+				m.tick( 0 );
+				button.tick( 0 );
+			}
+			m.skip( gap );
+			for (uint64_t ms = gap * Button::MS_PER_TICK; ms; ) {
+				uint32_t n = (ms > 4000000000ull) ? 4000000000u : (uint32_t)ms;
+				button.skipMillis( n );
+				ms -= n;
+			}
+			ticks += gap + 5;
+		}
+
+		c.update( button );
+		if (c.total[0] != m.cPressed || c.total[1] != m.cShort || c.total[2] != m.cLong
+				|| c.total[3] != m.cDouble || button.isDown != m.down || button.holdTime != m.holdTime) {
+			if (bad < 5)
+				printf( "segment %lu: pressed %llu/%llu short %llu/%llu long %llu/%llu double %llu/%llu"
+						" down %d/%d hold %u/%u\n", seg,
+					(unsigned long long)c.total[0], (unsigned long long)m.cPressed,
+					(unsigned long long)c.total[1], (unsigned long long)m.cShort,
+					(unsigned long long)c.total[2], (unsigned long long)m.cLong,
+					(unsigned long long)c.total[3], (unsigned long long)m.cDouble,
+					(int)button.isDown, (int)m.down, (unsigned)button.holdTime, (unsigned)m.holdTime );
+			bad++;
+			// carry on from the model's state
+			c.total[0] = m.cPressed;
+			c.total[1] = m.cShort;
+			c.total[2] = m.cLong;
+			c.total[3] = m.cDouble;
+		}
+	}
+	return bad;
+}
+
+
+/// feed `n` ticks of `level`
+static void feed( uint8_t level, unsigned long n )
+{
+	while (n--) button.tick( level );
+}
+
+
+/// @return # of false double presses across a ~2^32 ms idle time
+static unsigned wrap( unsigned runs, uint64_t& ticks )
+{
+	const unsigned long n = (1ull << 32) / Button::MS_PER_TICK - 2 * (BUTTON_NTICKS + 1);
+	unsigned bad = 0;
+
+	button.init();
+	for (unsigned k=0; k<runs; k++) {
+		feed( 1, BUTTON_NTICKS + 5 );
+		feed( 0, BUTTON_NTICKS + 20 );
+		uint8_t before = button.cDoublePress;
+		// end just under or over 2^32 ms after the release
+		feed( 0, n + k );
+		feed( 1, BUTTON_NTICKS + 5 );
+		feed( 0, BUTTON_NTICKS + 20 );
+		if (button.cDoublePress != before) bad++;
+		ticks += n + k + 2 * (2 * BUTTON_NTICKS + 25);
+	}
+	return bad;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	unsigned long segments = (argc > 1) ? atol( argv[1] ) : 4000000;
+	unsigned runs = (argc > 2) ? atoi( argv[2] ) : 4;
+	uint64_t ticks = 0;
+
+	srand( 11 );
+	unsigned long bad = model( segments, ticks );
+	printf( "model: %lu segments, %llu ticks (%.0f years at %d ms), %lu mismatches\n",
+		segments, (unsigned long long)ticks, ticks * (double)Button::MS_PER_TICK / 1000 / 86400 / 365,
+		Button::MS_PER_TICK, bad );
+
+	ticks = 0;
+	unsigned falseDouble = wrap( runs, ticks );
+	printf( "wrap: %llu ticks, %u false double presses\n", (unsigned long long)ticks, falseDouble );
+
+	return (bad || falseDouble) ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file 		  stress.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Multi-threaded stress test of `SharedButton`, for a host build with BUTTON_ATOMIC.
+ *
+ * One thread ticks a set of buttons with random input as fast as it can,
+ * the other threads read snapshots and check that they are consistent, i.e. that
+ * all fields come from the same tick:
+ * - `isDown` is 1 exactly when there was one more press than releases
+ * - a pending short press implies an open double-press window, and a released button
+ * - a press that started in the double-press window implies a pressed button
+ * - `holdTime` is a multiple of the tick period
+ * Readers also read the fields one by one, without the sequence lock, and count how
+ * often that gives an inconsistent result. Build with `make tsan` to let ThreadSanitizer
+ * check for data races.
+ *
+ * usage: stress [seconds] [readers]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#include <ButtonShared.h>
+
+#define NBUTTONS	4
+
+static SharedButton			buttons[NBUTTONS];
+static std::atomic<bool>	running( true );
+static std::atomic<unsigned long>	ticks( 0 );
+
+
+/// @brief true if snapshot is consistent
+static bool check( const ButtonSnapshot& s )
+{
+	uint8_t down = s.flags & 1;
+	bool pending = (s.flags & 2) != 0;
+	bool window = (s.flags & 4) != 0;
+
+	if ((uint8_t)(s.cPressed - s.cReleased) != down) return false;
+	if (pending && (!window || down)) return false;
+	if ((s.flags & 8) && !down) return false;
+	if (s.holdTime % Button::MS_PER_TICK) return false;
+	return true;
+}
+
+
+static void ticker()
+{
+	uint32_t rnd = 12345;
+	int run[NBUTTONS] = {0};
+	uint8_t level[NBUTTONS] = {0};
+	unsigned long n = 0;
+
+	while (running.load( std::memory_order_relaxed )) {
+		for (int i=0; i<NBUTTONS; i++) {
+			if (--run[i] <= 0) {
+				rnd = rnd * 1103515245u + 12345u;
+				level[i] = !level[i];
+				// mostly short presses, sometimes long ones. No runs shorter than
+				// BUTTON_NTICKS+1, those can give a release without a press
+				uint32_t r = (rnd >> 16) % 100;
+				run[i] = (r < 90) ? BUTTON_NTICKS + 1 + r : 100 + 10 * r;
+			}
+			buttons[i].tick( level[i] );
+			// keep counters away from saturation, so the first check stays valid
+			if (buttons[i].cReleased >= 200 && !buttons[i].isDown)
+				buttons[i].clearCounters();
+		}
+		n++;
+	}
+	ticks = n;
+}
+
+
+static void reader( unsigned long* bad, unsigned long* torn, unsigned long* reads )
+{
+	unsigned long b = 0, t = 0, r = 0;
+
+	while (running.load( std::memory_order_relaxed )) {
+		for (int i=0; i<NBUTTONS; i++) {
+			ButtonSnapshot s;
+			buttons[i].read( s );
+			if (!check( s )) b++;
+
+			// same fields, without the sequence lock
+			s.flags = buttons[i].isDown ? 1 : 0;
+			s.cPressed = buttons[i].cPressed;
+			s.cReleased = buttons[i].cReleased;
+			s.holdTime = buttons[i].holdTime;
+			if (!check( s )) t++;
+			r++;
+		}
+	}
+	*bad = b;
+	*torn = t;
+	*reads = r;
+}
+
+
+int main( int argc, char* argv[] )
+{
+	int seconds = (argc > 1) ? atoi( argv[1] ) : 5;
+	int nreaders = (argc > 2) ? atoi( argv[2] ) : 3;
+	std::vector<unsigned long> bad( nreaders ), torn( nreaders ), reads( nreaders );
+	std::vector<std::thread> threads;
+
+	for (int i=0; i<NBUTTONS; i++) buttons[i].init();
+
+	threads.emplace_back( ticker );
+	for (int k=0; k<nreaders; k++)
+		threads.emplace_back( reader, &bad[k], &torn[k], &reads[k] );
+	std::this_thread::sleep_for( std::chrono::seconds( seconds ) );
+	running = false;
+	for (auto& t : threads) t.join();
+
+	unsigned long sumBad = 0, sumTorn = 0, sumReads = 0;
+	for (int k=0; k<nreaders; k++) {
+		sumBad += bad[k];
+		sumTorn += torn[k];
+		sumReads += reads[k];
+	}
+	printf( "ticks %lu, snapshots %lu, inconsistent with seqlock %lu, without %lu\n",
+		ticks.load(), sumReads, sumBad, sumTorn );
+	return sumBad ? 1 : 0;
+}
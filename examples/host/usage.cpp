@@ -0,0 +1,151 @@
+/**
+ * @file 		  usage.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Check the `ButtonUsage` histograms.
+ *
+ * - bins: every duration from 0 to 65535 ms must fall into the bin whose range holds
+ *   it, i.e. `binStart(b) <= ms < binStart(b+1)`, the last bin without upper limit.
+ * - presses: a `ButtonCore` gets presses from 30 ms to 70 s, each in the middle of a
+ *   bin, and gaps up to 100 s. Each press must go to its bin in the duration histogram,
+ *   each interval to its bin in the interval histogram, those over 65535 ms to the last.
+ * - saturation: 70000 releases must leave their bin at UINT16_MAX, the others at 0,
+ *   and `read()` with reset must clear both histograms and the gesture counters.
+ *
+ * usage: usage
+ * Exit code is 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Button.h>
+#include <ButtonUsage.h>
+
+static ButtonCore button;
+static ButtonUsage usage;
+static uint32_t now;		// ms
+
+
+/// @return # of durations in the wrong bin
+static unsigned long bins()
+{
+	unsigned long bad = 0;
+	for (uint32_t ms=0; ms<=UINT16_MAX; ms++) {
+		uint8_t b = ButtonUsage::bin( (uint16_t)ms );
+		bool ok = b < BUTTON_HIST_BINS && ButtonUsage::binStart( b ) <= ms
+			&& (b == BUTTON_HIST_BINS-1 || ms < ButtonUsage::binStart( b+1 ));
+		if (!ok) {
+			if (bad < 5) printf( "bins: %u ms in bin %u\n", (unsigned)ms, b );
+			bad++;
+		}
+	}
+	printf( "bins: %u bins, bin 0 below %u ms, last bin from %u ms, %lu durations wrong\n",
+		BUTTON_HIST_BINS, ButtonUsage::binStart( 1 ), ButtonUsage::binStart( BUTTON_HIST_BINS-1 ), bad );
+	return bad;
+}
+
+
+/// `ticks` ticks of `level`
+static void feed( uint8_t level, uint32_t ticks )
+{
+	while (ticks--) {
+		now += Button::MS_PER_TICK;
+		usage.tick( button.tickInline( level ), button, now );
+	}
+}
+
+
+/// @return # of wrong histogram counts
+static unsigned presses()
+{
+	// durations in the middle of bins, for the default BUTTON_HIST_SHIFT of 6
+	const uint32_t durations[] = { 30, 100, 200, 400, 700, 1500, 3000, 6000, 12000, 30000, 70000 };
+	const uint32_t gaps[] = { 100, 500, 2000, 100000 };
+	uint16_t duration[BUTTON_HIST_BINS] = { 0 }, interval[BUTTON_HIST_BINS] = { 0 };
+	uint32_t lastPress = 0;
+	unsigned n = 0, bad = 0;
+
+	button.init();
+	usage.clear();
+	feed( 0, 100 );
+	for (uint32_t gap : gaps) {
+		for (uint32_t d : durations) {
+			uint32_t pressAt = now + BUTTON_NTICKS * Button::MS_PER_TICK;
+			// the debounced press lasts as long as the input, just later
+			uint32_t held = (d > UINT16_MAX - Button::MS_PER_TICK) ? UINT16_MAX : d;
+			duration[ ButtonUsage::bin( (uint16_t)held ) ]++;
+			if (n++) {
+				uint32_t dt = pressAt - lastPress;
+				interval[ ButtonUsage::bin( (dt > UINT16_MAX) ? UINT16_MAX : (uint16_t)dt ) ]++;
+			}
+			lastPress = pressAt;
+			feed( 1, d / Button::MS_PER_TICK );
+			feed( 0, gap / Button::MS_PER_TICK );
+		}
+	}
+
+	ButtonUsageSnapshot snap;
+	usage.read( snap, button, false );
+	for (uint8_t b=0; b<BUTTON_HIST_BINS; b++) {
+		bool ok = snap.duration[b] == duration[b] && snap.interval[b] == interval[b];
+		printf( "presses: bin %u from %5u ms: durations %2u/%2u, intervals %2u/%2u %s\n",
+			b, ButtonUsage::binStart( b ), snap.duration[b], duration[b], snap.interval[b], interval[b],
+			ok ? "ok" : "WRONG" );
+		if (!ok) bad++;
+	}
+	return bad;
+}
+
+
+/// @return # of failed checks
+static unsigned saturation()
+{
+	unsigned bad = 0;
+	ButtonUsageSnapshot snap;
+
+	button.init();
+	usage.clear();
+	button.holdTime = 1000;
+	for (uint32_t i=0; i<70000; i++) usage.tick( Debounce::RELEASE, button, 0 );
+	button.cShortPress = 7;
+
+	usage.read( snap, button, true );
+	uint8_t b = ButtonUsage::bin( 1000 );
+	for (uint8_t k=0; k<BUTTON_HIST_BINS; k++)
+		if (snap.duration[k] != ((k == b) ? UINT16_MAX : 0) || snap.interval[k] != 0) bad++;
+	if (snap.cShortPress != 7) bad++;
+
+	// read with reset clears everything
+	usage.read( snap, button, false );
+	for (uint8_t k=0; k<BUTTON_HIST_BINS; k++)
+		if (snap.duration[k] || snap.interval[k]) bad++;
+	if (snap.cShortPress || button.cShortPress) bad++;
+
+	printf( "saturation: 70000 releases in bin %u, %s\n", b, bad ? "WRONG" : "ok" );
+	return bad;
+}
+
+
+int main()
+{
+	unsigned long bad = bins();
+	bad += presses();
+	bad += saturation();
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file 		  main.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. 
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Measure execution time and stack usage of the debouncer, in simavr.
+ *
+ * For each scenario (i.e. each branch through `Button::tick()`), the buttons are 
+ * first driven into the state just before the event, then the tick that fires 
+ * the event is timed with Timer1 running at F_CPU, for 1..MAX_BUTTONS buttons.
+ * The tick runs in a real interrupt vector, triggered in software by toggling an
+ * output pin with pin-change interrupt enabled. Timer1 is read before the trigger and
+ * after the vector has returned, minus the same code toggling a pin without interrupt.
+ * So the cycles count from the trigger to `reti`: interrupt response, prologue, the
+ * ticks, epilogue and `reti`. Two vectors are measured: 
+ * - "isr"    : PCINT0 calls `Button::isr()` -> `tick()` -> virtual `pressed()`, like AvrTimers
+ * - "inline" : PCINT1 calls `tickInline()`, inlined into the vector, as in a user ISR
+ *
+ * Then, per feature level, the size of the class and the cycles of a vector calling
+ * `tickInline()` of one object, for each scenario: `Contact` (INT0), `CountedContact`
+ * (INT1), `ButtonCore` (PCINT2) and `Button` (the "inline" vector).
+ *
+ * Before that, the debounce core of the variant is checked against the portable C++
+ * code and the table generator, for all 256 states and both input levels.
+ *
+ * Results are written to the simavr console as CSV lines
+ *   check,<variant>,<mismatches>
+ *   wcet,<variant>,<path>,<#buttons>,<scenario>,<cycles>
+ *   size,<variant>,<class>,<bytes>
+ *   class,<variant>,<class>,<scenario>,<cycles>
+ *   stack,<variant>,<bytes>
+ * and the program ends by sleeping with interrupts disabled, which stops simavr.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr_mcu_section.h>
+
+#include <Button.h>
+
+AVR_MCU( F_CPU, "atmega328p" );
+AVR_MCU_SIMAVR_CONSOLE( &GPIOR0 );
+
+#if defined(BUTTON_DEBOUNCE_TABLE)
+ #define VARIANT "table"
+#else
+ #define VARIANT "c"
+#endif
+
+#ifndef MAX_BUTTONS
+ #define MAX_BUTTONS 8
+#endif
+
+#define STACK_PAINT	0xC5
+
+extern uint8_t __heap_start;
+
+//----------------------------------------------------------------------------
+
+/// Button whose input is set by the test program
+class SimButton : public Button {
+	public:
+		uint8_t	level;
+		virtual bool pressed() { return level != 0; }
+};
+
+SimButton buttons[MAX_BUTTONS];
+static Contact contact;
+static CountedContact counted;
+static ButtonCore core;
+
+static volatile uint8_t gCount;		///< # of buttons ticked by the vectors
+static volatile uint8_t gLevel;		///< input level for the "inline" vector
+
+enum Scenario { 
+	IDLE, PRESS, HOLD, RELEASE_SHORT, SHORT_PRESS, RELEASE_DOUBLE, RELEASE_LONG, 
+	NSCENARIOS 
+};
+
+const char* const scenarioNames[NSCENARIOS] = { 
+	"idle", "press", "hold", "release_short", "short_press", "release_double", "release_long" 
+};
+
+//----------------------------------------------------------------------------
+
+static void conPutc( char c )
+{
+	GPIOR0 = c;
+}
+
+
+static void conPuts( const char* s )
+{
+	while (*s) conPutc( *s++ );
+}
+
+
+static void conPutu( uint16_t u )
+{
+	char buf[6];
+	uint8_t i = 0;
+	do { buf[i++] = '0' + u % 10; u /= 10; } while (u);
+	while (i) conPutc( buf[--i] );
+}
+
+//----------------------------------------------------------------------------
+
+/// reference: the portable C++ debounce core, i.e. `Debounce::step()` without build flags
+static uint8_t refStep( uint8_t& state, uint8_t isPressed )
+{
+	state = (uint8_t)(state << 1) | (isPressed ? 1 : 0);
+	if ((state & Debounce::MASK) == Debounce::RISE) return Debounce::PRESS;
+	if ((state & Debounce::MASK) == Debounce::FALL) return Debounce::RELEASE;
+	return Debounce::NONE;
+}
+
+
+/**
+ * @brief Compare `Debounce::step()` of this variant and the table entries with the
+ * reference, for each state and input level.
+ * Only the last N+1 samples of the new state are compared, the table keeps no more.
+ * @return	# of mismatches in edge or new state
+ */
+static uint16_t checkCore()
+{
+	uint16_t errors = 0;
+	uint8_t state = 0;
+	do {
+		for (uint8_t in=0; in<2; in++) {
+			uint8_t sv = state, sr = state;
+			uint8_t ev = Debounce::step( sv, in );
+			uint8_t er = refStep( sr, in );
+			uint8_t t = Debounce::entry( ((uint8_t)(state << 1) | in) & (Debounce::TABLE_SIZE-1) );
+			if (ev != er || (sv & Debounce::MASK) != (sr & Debounce::MASK)) errors++;
+			if ((t >> 6) != er || (t & Debounce::MASK) != (sr & Debounce::MASK)) errors++;
+		}
+	} while (++state);
+	return errors;
+}
+
+//----------------------------------------------------------------------------
+
+/// feed `n` samples of `level` to all buttons, and to the objects of the other classes
+static void feed( uint8_t nb, uint8_t level, uint8_t n )
+{
+	while (n--) {
+		for (uint8_t i=0; i<nb; i++) 
+			buttons[i].tick( level );
+		contact.tickInline( level );
+		counted.tickInline( level );
+		core.tickInline( level );
+	}
+}
+
+
+/**
+ * @brief Drive buttons into the state just before the event of interest.
+ * @return	the input level for the tick that fires the event
+ */
+static uint8_t prepare( uint8_t nb, uint8_t scenario )
+{
+	const uint8_t doubleTicks = Button::MAX_DOUBLE_PRESS / Button::MS_PER_TICK;
+	const uint8_t longTicks = Button::MIN_LONG_PRESS / Button::MS_PER_TICK;
+
+	// get rid of leftovers from previous scenario, incl. pending short press
+	feed( nb, 0, 2*doubleTicks );
+	switch (scenario) {
+		case IDLE:
+			return 0;
+		case PRESS:
+			feed( nb, 1, BUTTON_NTICKS-1 );
+			return 1;
+		case HOLD:
+			feed( nb, 1, BUTTON_NTICKS+1 );
+			return 1;
+		case RELEASE_SHORT:
+			feed( nb, 1, BUTTON_NTICKS+1 );
+			feed( nb, 0, BUTTON_NTICKS-1 );
+			return 0;
+		case SHORT_PRESS:
+			feed( nb, 1, BUTTON_NTICKS+1 );
+			feed( nb, 0, BUTTON_NTICKS+doubleTicks );
+			return 0;
+		case RELEASE_DOUBLE:
+			feed( nb, 1, BUTTON_NTICKS+1 );
+			feed( nb, 0, BUTTON_NTICKS );
+			feed( nb, 1, BUTTON_NTICKS+1 );
+			feed( nb, 0, BUTTON_NTICKS-1 );
+			return 0;
+		case RELEASE_LONG:
+			feed( nb, 1, longTicks+BUTTON_NTICKS+1 );
+			feed( nb, 0, BUTTON_NTICKS-1 );
+			return 0;
+	}
+	return 0;
+}
+
+
+/*
+	Software interrupts: a pin-change interrupt fires when its pin toggles, also when
+	the pin is an output. Writing 1 to a bit of PINx toggles the pin.
+	  PB0 = PCINT0	"isr" vector
+	  PC0 = PCINT8	"inline" vector
+	  PD2 = INT0	`Contact`
+	  PD3 = INT1	`CountedContact`
+	  PD4 = PCINT20	`ButtonCore`
+	  PB1			no interrupt enabled, for the overhead of the trigger itself
+*/
+
+ISR(PCINT0_vect)
+{
+	uint8_t nb = gCount;
+	for (uint8_t i=0; i<nb; i++) 
+		Button::isr( &buttons[i] );
+}
+
+
+ISR(PCINT1_vect)
+{
+	uint8_t nb = gCount, level = gLevel;
+	for (uint8_t i=0; i<nb; i++) 
+		buttons[i].tickInline( level );
+}
+
+
+ISR(INT0_vect)
+{
+	contact.tickInline( gLevel );
+}
+
+
+ISR(INT1_vect)
+{
+	counted.tickInline( gLevel );
+}
+
+
+ISR(PCINT2_vect)
+{
+	core.tickInline( gLevel );
+}
+
+
+/**
+ * @brief Toggle a pin and time it until the vector, if any, has returned.
+ * The pin change passes a synchronizer before the interrupt is taken, the nops keep
+ * the second read of Timer1 behind that. They are counted in the overhead as well.
+ * @return	# of cycles
+ */
+static BUTTON_ALWAYS_INLINE uint16_t trigger( volatile uint8_t& pin, uint8_t bit )
+{
+	uint16_t t0 = TCNT1;
+	pin = bit;
+	asm volatile( "nop\n\tnop\n\tnop\n\tnop\n\tnop\n\tnop\n\tnop\n\tnop" ::: "memory" );
+	uint16_t t1 = TCNT1;
+	return t1 - t0;
+}
+
+
+enum Path { PATH_ISR, PATH_INLINE, PATH_CONTACT, PATH_COUNTED, PATH_CORE };
+
+/// run one measurement through the vector of `path`, return # of cycles from trigger to `reti`
+static uint16_t measure( uint8_t path, uint8_t nb, uint8_t level )
+{
+	uint16_t cycles;
+	gCount = nb;
+	gLevel = level;
+	uint16_t overhead = trigger( PINB, _BV(PB1) );
+	switch (path) {
+		case PATH_ISR:		cycles = trigger( PINB, _BV(PB0) );	break;
+		case PATH_INLINE:	cycles = trigger( PINC, _BV(PC0) );	break;
+		case PATH_CONTACT:	cycles = trigger( PIND, _BV(PD2) );	break;
+		case PATH_COUNTED:	cycles = trigger( PIND, _BV(PD3) );	break;
+		default:			cycles = trigger( PIND, _BV(PD4) );	break;
+	}
+	return cycles - overhead;
+}
+
+//----------------------------------------------------------------------------
+
+int main()
+{
+	// paint the stack, so we can find the high-water mark later
+	for (uint8_t* p = &__heap_start; p < (uint8_t*)SP - 16; p++) 
+		*p = STACK_PAINT;
+
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);		// free running, at F_CPU
+	DDRB = _BV(PB0) | _BV(PB1);
+	DDRC = _BV(PC0);
+	DDRD = _BV(PD2) | _BV(PD3) | _BV(PD4);
+	PCMSK0 = _BV(PCINT0);
+	PCMSK1 = _BV(PCINT8);
+	PCMSK2 = _BV(PCINT20);
+	PCICR = _BV(PCIE0) | _BV(PCIE1) | _BV(PCIE2);
+	EICRA = _BV(ISC00) | _BV(ISC10);	// INT0, INT1 on any change
+	EIMSK = _BV(INT0) | _BV(INT1);
+	sei();
+
+	conPuts( "check," VARIANT "," ); 
+	conPutu( checkCore() ); conPutc( '\n' );
+
+	const char* const pathNames[2] = { "isr", "inline" };
+
+	for (uint8_t path=0; path<2; path++) {
+		for (uint8_t nb=1; nb<=MAX_BUTTONS; nb <<= 1) {
+			for (uint8_t sc=0; sc<NSCENARIOS; sc++) {
+				uint8_t level = prepare( nb, sc );
+				for (uint8_t i=0; i<nb; i++) buttons[i].level = level;
+				uint16_t cycles = measure( path, nb, level );
+				conPuts( "wcet," VARIANT "," ); 
+				conPuts( pathNames[path] ); conPutc( ',' ); 
+				conPutu( nb ); conPutc( ',' ); 
+				conPuts( scenarioNames[sc] ); conPutc( ',' ); 
+				conPutu( cycles ); conPutc( '\n' );
+			}
+		}
+	}
+
+	// per feature level: size, and one object ticked by its own vector
+	const char* const classNames[4] = { "Contact", "CountedContact", "ButtonCore", "Button" };
+	const uint8_t classSizes[4] = { sizeof(Contact), sizeof(CountedContact), sizeof(ButtonCore), sizeof(Button) };
+	const uint8_t classPaths[4] = { PATH_CONTACT, PATH_COUNTED, PATH_CORE, PATH_INLINE };
+
+	for (uint8_t c=0; c<4; c++) {
+		conPuts( "size," VARIANT "," ); 
+		conPuts( classNames[c] ); conPutc( ',' ); 
+		conPutu( classSizes[c] ); conPutc( '\n' );
+		for (uint8_t sc=0; sc<NSCENARIOS; sc++) {
+			uint8_t level = prepare( 1, sc );
+			buttons[0].level = level;
+			uint16_t cycles = measure( classPaths[c], 1, level );
+			conPuts( "class," VARIANT "," ); 
+			conPuts( classNames[c] ); conPutc( ',' ); 
+			conPuts( scenarioNames[sc] ); conPutc( ',' ); 
+			conPutu( cycles ); conPutc( '\n' );
+		}
+	}
+
+	// stack high-water mark
+	uint8_t* p = &__heap_start;
+	while (p < (uint8_t*)RAMEND && *p == STACK_PAINT) p++;
+	conPuts( "stack," VARIANT "," ); 
+	conPutu( (uint8_t*)RAMEND - p ); conPutc( '\n' );
+
+	// stop the simulator
+	cli();
+	set_sleep_mode( SLEEP_MODE_PWR_DOWN );
+	sleep_enable();
+	sleep_cpu();
+	for (;;) ;
+}
@@ -33,6 +33,11 @@
  *    then call `tick(void)` repeatedly
  * 3. using class Button, just call `tick(uint8_t)` repeatedly, 
  *    providing the current status of the button contact
+ *
+ * If only the debounced state or only edge counts are needed, the smaller classes 
+ * `Contact` and `CountedContact` leave out the gesture logic and its fields entirely.
+ * `ButtonCore` has the full gesture logic, but no virtual `pressed()` and no vtable,
+ * e.g. for variant 3 or for the C interface in `ButtonC.h`.
  * 
  * The variants 2 and 3 where the Button class instance itself has no knowledge of 
  * which port and pin the button is attached to are particularly useful 
@@ -47,13 +52,22 @@
  * 2. short button press (duration <1s), reported 200ms after release, via cShortPress
  * 3. long button press (duration >1s), reported at release, via cLongPress
  * 4. double press (press <200ms after previous release), reported at release, via cDoublePress
+ *
+ * There is no free-running clock: the time since the last release is only counted 
+ * while the double-press window is open, so it never exceeds ~200ms plus one tick, 
+ * and `holdTime` saturates. All comparisons are therefore valid for any uptime, 
+ * and a button pressed within 200ms after init() is not mistaken for a double press.
  */ 
 
 #include <inttypes.h>
 #include <stdbool.h>
 #include <limits.h>
 #include <string.h>
-#include <avr/io.h>
+#ifdef __AVR__
+ #include <avr/io.h>
+#else
+ #define _BV(bit) (1 << (bit))
+#endif
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
 
@@ -62,38 +76,29 @@ extern "C" unsigned long millis(void);
 
 #include "Button.h"
 
-/*
-    The debounce logic samples the state of the button input multiple times
-    and accumulates samples in a variable (max 8 samples).
-    A valid keypress is a pattern of 1x not pressed, then N times pressed, 
-    e.g. 0,1,1,1 for N=3
-    A valid key release is a pattern of 1x pressed, then N times not pressed, 
-    e.g. 1,0,0,0 for N=3
-*/
-
-// level must be steady for 3 ticks
-#define NTICKS 3        
-// how may samples to look at?
-#define MASK ((1 << (NTICKS+1))-1)
-// expected pattern at start of keypress
-#define RISE ((1 << NTICKS)-1)
-
-
 /** 
  * @defgroup Button  <Button.hpp>: a class for reading and debouncing a button or contact.
  * @{
  */
 
 
+#ifdef BUTTON_RUNTIME_THRESHOLDS
+uint16_t ButtonCore::longPressMs = ButtonCore::MIN_LONG_PRESS;
+uint16_t ButtonCore::doublePressMs = ButtonCore::MAX_DOUBLE_PRESS;
+#endif
+
+
 /**
  * @brief Initialize basic button instance.
  * 
  */
-void Button::init()
+void ButtonCore::init()
 {
 	mMillisPerTick = MS_PER_TICK;
-	mState = 0;
-	isDown = false;
+	mWindow = false;
+	mDouble = false;
+	mPending = false;
+	Contact::init();
 }
 
 
@@ -115,49 +120,136 @@ void Button::isr(void* arg)
  * @param	isPressed	!=0 if physical button is currently pressed
  * @param   ms_per_tick  milliseconds since last tick
  */
-void Button::tick( uint8_t isPressed )
+void ButtonCore::tick( uint8_t isPressed )
 {
-	mMillis += mMillisPerTick;
+	tickInline( isPressed );
+}
 
-	mState <<= 1;
-	mState |= isPressed ? 1 : 0;
 
-    // just pressed? look for e.g. [na na na na 0 1 1 1] pattern 
-	if ((mState & MASK) == RISE) {
-		if (cPressed < UINT8_MAX) cPressed++;
-		isDown = true;
-		holdTime = 0;	// start measuring duration
-		mPending = false;
+/**
+ * @brief Earliest time the debouncer needs attention, for tickless operation.
+ *
+ * An application that wants to sleep instead of ticking every 10ms programs a 
+ * one-shot timer for this many ticks (and a pin-change interrupt), then calls 
+ * `idle()` with the # of ticks actually slept before resuming `tick()`.
+ * While debouncing is in progress, every tick is needed. While the button is 
+ * held, nothing changes except `holdTime`, which `idle()` catches up on.
+ * 
+ * @return # of ticks, 1 = keep ticking, `NO_WAKEUP` = only on an input change
+ */
+uint16_t ButtonCore::nextWakeupTicks() const
+{
+	if (!isStable()) return 1;
+	if (!mPending) return NO_WAKEUP;
+
+	// short press is reported on the first tick with mSinceReleased > doublePressMs
+	uint16_t since = mSinceReleased;
+	if (since > doublePressMs) return 1;
+	return (doublePressMs - since) / mMillisPerTick + 1;
+}
+
+
+/**
+ * @brief Account for ticks that were skipped while sleeping, the input has not changed.
+ * Same result as calling `tick()` `ticks` times with the previous input level, but 
+ * only takes time for the ticks needed to complete debouncing.
+ * 
+ * @param ticks	# of ticks that passed without a call to `tick()`
+ */
+void ButtonCore::idle( uint16_t ticks )
+{
+	// debouncing in progress: must really be done tick by tick
+	for ( ; ticks && !isStable(); ticks--) 
+		tickInline( lastSample() );
+	if (!ticks) return;
 
-		mLastPressed = mMillis;
+	if (mWindow) {
+		uint32_t since = mSinceReleased + (uint32_t)ticks * mMillisPerTick;
+		mSinceReleased = (since > UINT16_MAX) ? UINT16_MAX : (uint16_t)since;
 	}
-    // just released? look for e.g. [na na na na 1 0 0 0] pattern
-	if ((mState | ~MASK) == ~RISE) {
-		if (cReleased < UINT8_MAX) cReleased++;
-		isDown = false;
-
-		if (holdTime > MIN_LONG_PRESS) {
-			// long press (pressed for more than 1000ms) ?
-			if (cLongPress < UINT8_MAX) cLongPress++;			
-		} else if ((uint32_t)(mLastPressed - mLastReleased) < MAX_DOUBLE_PRESS) {
-			// double press (this start less than 200ms after previous end)?
-			if (cDoublePress < UINT8_MAX) cDoublePress++;
-		} else {
-			// might be a double click, wait and see
-			mPending = true;
+	if (isDown) {
+		// same limit as in tickInline()
+		uint16_t h = holdTime;
+		if (h < UINT16_MAX-mMillisPerTick) {
+			uint16_t n = (UINT16_MAX-mMillisPerTick-h + mMillisPerTick-1) / mMillisPerTick;
+			if (n > ticks) n = ticks;
+			holdTime = h + n * mMillisPerTick;
 		}
-		mLastReleased = mMillis;
 	}
-	if (isDown && (holdTime < UINT16_MAX-mMillisPerTick))
-		holdTime += mMillisPerTick;
-	if (mPending && ((uint32_t)(mMillis - mLastReleased) > MAX_DOUBLE_PRESS)) {
-		//it's not a double click
-		mPending = false;
-		if (cShortPress < UINT8_MAX) cShortPress++;			
+	if (mWindow && (mSinceReleased > doublePressMs)) {
+		mWindow = false;
+		if (mPending) {
+			//it's not a double click
+			mPending = false;
+			if (cShortPress < UINT8_MAX) cShortPress++;			
+			BUTTON_TRACE( TRACE_SHORT, (Contact*)this );
+		}
 	}
 }
 
 
+/**
+ * @brief Account for time without ticks, e.g. while the timer was stopped in power-down.
+ * The input is assumed not to have changed. Takes constant time for any `ms`: 
+ * once a sleep is long enough for `holdTime` to saturate and the double-press 
+ * window to close, a longer one makes no difference to the gesture logic.
+ * 
+ * @param ms	time skipped [ms], rounded down to whole ticks
+ */
+void ButtonCore::skipMillis( uint32_t ms )
+{
+	const uint32_t settled = UINT16_MAX / mMillisPerTick + doublePressMs / mMillisPerTick + BUTTON_NTICKS + 2;
+	uint32_t ticks = ms / mMillisPerTick;
+
+	if (ticks > settled) ticks = settled;
+	while (ticks) {
+		uint16_t n = (ticks > UINT16_MAX) ? UINT16_MAX : (uint16_t)ticks;
+		idle( n );
+		ticks -= n;
+	}
+}
+
+
+/**
+ * @brief Save debouncer state in a compact form.
+ * @param snap	receives state
+ */
+void ButtonCore::save( ButtonSnapshot& snap ) const
+{
+	snap.state = mState;
+	snap.flags = (isDown ? 1 : 0) | (mPending ? 2 : 0) | (mWindow ? 4 : 0) | (mDouble ? 8 : 0);
+	snap.cPressed = cPressed;
+	snap.cReleased = cReleased;
+	snap.cShortPress = cShortPress;
+	snap.cLongPress = cLongPress;
+	snap.cDoublePress = cDoublePress;
+	snap.holdTime = holdTime;
+	snap.sinceReleased = mSinceReleased;
+}
+
+
+/**
+ * @brief Restore debouncer state saved by `save()`.
+ * Follow with `skipMillis()` if time has passed since the state was saved.
+ * @param snap	state to restore
+ */
+void ButtonCore::restore( const ButtonSnapshot& snap )
+{
+	mState = snap.state;
+	isDown = (snap.flags & 1) != 0;
+	mPending = (snap.flags & 2) != 0;
+	mWindow = (snap.flags & 4) != 0;
+	mDouble = (snap.flags & 8) != 0;
+	cPressed = snap.cPressed;
+	cReleased = snap.cReleased;
+	cShortPress = snap.cShortPress;
+	cLongPress = snap.cLongPress;
+	cDoublePress = snap.cDoublePress;
+	holdTime = snap.holdTime;
+	mSinceReleased = snap.sinceReleased;
+}
+
+
 /**
  * @brief Define which pin to poll.
  * 
@@ -19,6 +19,11 @@
 #ifndef BUTTON_H_
 #define BUTTON_H_
 
+#include "ButtonDebounce.h"
+#ifdef BUTTON_EVENTS
+ #include "ButtonEvents.h"
+#endif
+
 /** 
  * @ingroup Button
  * @{
@@ -26,17 +31,97 @@
 
 
 /**
- * @brief Base class for debouncing a button, polling the hardware happens elsewhere
- * 
+ * @brief Debounced state only, e.g. for window contacts.
+ * Smallest feature level: no vtable, no timing, no counters.
  */
-class Button {
+class Contact {
+#ifdef BUTTON_EVENTS
+	friend class ButtonEvents;
+#endif
+	protected:
+		BUTTON_SHARED(uint8_t)	mState;
+
+	public:
+		/// `nextWakeupTicks()` result if no tick is needed until the input changes
+		static const uint16_t	NO_WAKEUP = UINT16_MAX;
+
+#ifdef BUTTON_EVENTS
+		Contact() : mEventSource(0) { init(); }
+		/// index+1 of this button in `buttonEvents`, 0 if not added
+		uint8_t eventSource() const { return mEventSource; }
+#else
+		Contact() { init(); }
+#endif
+		void init() { mState = 0; isDown = false; }
+
+		BUTTON_ALWAYS_INLINE uint8_t tickInline( uint8_t isPressed );
+
+		/// true if debouncing is complete, i.e. nothing happens until the input changes
+		bool isStable() const { return Debounce::stable( mState ); }
+		/// most recent raw sample
+		uint8_t lastSample() const { return mState & 1; }
+
+		/// # of ticks until the next tick is needed, assuming the input does not change
+		uint16_t nextWakeupTicks() const { return isStable() ? NO_WAKEUP : 1; }
+		/// account for `ticks` ticks without sampling, the input has not changed
+		void idle( uint16_t ticks ) { for ( ; ticks && !isStable(); ticks--) tickInline( lastSample() ); }
+
+		BUTTON_SHARED(bool)		isDown;			///< true if button is currently pressed.
+#ifdef BUTTON_BOUNCE_STATS
+		BUTTON_SHARED(uint16_t)	cRawEdges;		///< count # of raw input changes, incl. bounces, can be reset by application.
+#endif
+#ifdef BUTTON_EVENTS
+
 	private:
-		volatile uint8_t	mState;
-		volatile uint32_t	mLastPressed;
-		volatile uint32_t	mLastReleased;
-		volatile uint32_t	mMillis;
-		volatile bool		mPending;
-				 uint8_t	mMillisPerTick;
+		uint8_t				mEventSource;	// index+1 in `buttonEvents`, 0=not added
+#endif
+};
+
+
+/**
+ * @brief Debounced state plus count of presses and releases.
+ * Middle feature level: no vtable, no timing.
+ */
+class CountedContact : public Contact {
+	public:
+		BUTTON_ALWAYS_INLINE uint8_t tickInline( uint8_t isPressed );
+
+		/// account for `ticks` ticks without sampling, the input has not changed
+		void idle( uint16_t ticks ) { for ( ; ticks && !isStable(); ticks--) tickInline( lastSample() ); }
+
+		BUTTON_SHARED(uint8_t)	cPressed;		///< count # of times debounced button was pressed, can be reset by application.
+		BUTTON_SHARED(uint8_t)	cReleased;		///< count # of times debounced button was released, can be reset by application.
+};
+
+
+/**
+ * @brief Compact copy of the state of a `ButtonCore` or `Button`, e.g. to keep it in EEPROM across power-down.
+ */
+struct ButtonSnapshot {
+	uint8_t		state;			///< sample history
+	uint8_t		flags;			///< bit 0: isDown, 1: short press pending, 2: window open, 3: press started in window
+	uint8_t		cPressed;
+	uint8_t		cReleased;
+	uint8_t		cShortPress;
+	uint8_t		cLongPress;
+	uint8_t		cDoublePress;
+	uint16_t	holdTime;
+	uint16_t	sinceReleased;	///< ms since last release, if double-press window is open
+};
+
+
+/**
+ * @brief Debounce a button and detect gestures, without a vtable.
+ * Full feature level: counts, hold time and gestures. Feed it samples via
+ * `tick(uint8_t)` or `tickInline(uint8_t)`.
+ */
+class ButtonCore : public CountedContact {
+	private:
+		BUTTON_SHARED(uint16_t)	mSinceReleased;	// ms since last release, only counted while mWindow
+		BUTTON_SHARED(bool)		mWindow;		// double-press window is open
+		BUTTON_SHARED(bool)		mDouble;		// current press started within the window
+		BUTTON_SHARED(bool)		mPending;
+		uint8_t				mMillisPerTick;
 		
 	public:
 		/// recommended poll interval in ms.
@@ -46,25 +131,163 @@ class Button {
 		/// max separation (#1 end to #2 start) for double click [ms]; typically 60-180ms
 		static const uint16_t	MAX_DOUBLE_PRESS = 200u;	
 
-		Button() { init(); }
+#ifdef BUTTON_RUNTIME_THRESHOLDS
+		static uint16_t			longPressMs;	///< current minimum long press duration [ms]
+		static uint16_t			doublePressMs;	///< current max separation for double click [ms]
+		static void setLongPress( uint16_t ms ) { longPressMs = (ms > 60000u) ? 60000u : ms; }
+		static void setDoublePress( uint16_t ms ) { doublePressMs = (ms > 30000u) ? 30000u : ms; }
+#else
+		static const uint16_t	longPressMs = MIN_LONG_PRESS;
+		static const uint16_t	doublePressMs = MAX_DOUBLE_PRESS;
+#endif
+
+		ButtonCore() { init(); }
 		void init();
 
-		void tick() { tick( pressed() ); }
         void tick( uint8_t isPressed );
-
-        virtual bool pressed() { return false; }   // must be instantiated in a derived class by application
+		BUTTON_ALWAYS_INLINE uint8_t tickInline( uint8_t isPressed );
 
 		void setMillisPerTick(uint8_t ms) { if (ms) mMillisPerTick=ms; }
 
+		uint16_t nextWakeupTicks() const;
+		void idle( uint16_t ticks );
+		void skipMillis( uint32_t ms );
+
+		void save( ButtonSnapshot& snap ) const;
+		void restore( const ButtonSnapshot& snap );
+
+		BUTTON_SHARED(uint16_t)	holdTime;		///< duration of current button press, in ms.
+		BUTTON_SHARED(uint8_t)	cShortPress;	///< count # of short presses detected, can be reset by application
+		BUTTON_SHARED(uint8_t)	cLongPress;		///< count # of long presses detected, can be reset by application
+		BUTTON_SHARED(uint8_t)	cDoublePress;   ///< count # of double clicks detected, can be reset by application
+};
+
+
+/**
+ * @brief Base class for debouncing a button, polling the hardware happens elsewhere
+ * Full feature level plus virtual `pressed()`, for `tick(void)` and `isr()`.
+ */
+class Button : public ButtonCore {
+	public:
+		using ButtonCore::tick;
+		void tick() { tick( pressed() ); }
+
+        virtual bool pressed() { return false; }   // must be instantiated in a derived class by application
+
 		static void isr(void* arg);
+};
+
+
+/** 
+ * @brief Do debouncing, inlined into the caller.
+ * @param	isPressed	!=0 if physical button is currently pressed
+ * @return  `Debounce::PRESS` or `Debounce::RELEASE` if an edge was detected, else `Debounce::NONE`
+ */
+BUTTON_ALWAYS_INLINE uint8_t Contact::tickInline( uint8_t isPressed )
+{
+	uint8_t state = mState;
+	uint8_t edge = Debounce::step( state, isPressed );
+	mState = state;
+#ifdef BUTTON_BOUNCE_STATS
+	// bit 0 is the new sample, bit 1 the previous one
+	if ((((state >> 1) ^ state) & 1) && (cRawEdges < UINT16_MAX)) cRawEdges++;
+#endif
+
+	if (edge == Debounce::PRESS) {
+		isDown = true;
+		BUTTON_TRACE( TRACE_PRESS, this );
+	} else if (edge == Debounce::RELEASE) {
+		isDown = false;
+		BUTTON_TRACE( TRACE_RELEASE, this );
+	}
+	return edge;
+}
+
+
+/** 
+ * @brief Do debouncing and count edges, inlined into the caller.
+ * @param	isPressed	!=0 if physical button is currently pressed
+ * @return  `Debounce::PRESS` or `Debounce::RELEASE` if an edge was detected, else `Debounce::NONE`
+ */
+BUTTON_ALWAYS_INLINE uint8_t CountedContact::tickInline( uint8_t isPressed )
+{
+	uint8_t edge = Contact::tickInline( isPressed );
+
+	if (edge == Debounce::PRESS) {
+		if (cPressed < UINT8_MAX) cPressed++;
+	} else if (edge == Debounce::RELEASE) {
+		if (cReleased < UINT8_MAX) cReleased++;
+	}
+	return edge;
+}
+
+
+/** 
+ * @brief Do debouncing and gesture detection, inlined into the caller.
+ * Same as `tick(uint8_t)`, but the compiler sees the whole path, so an ISR 
+ * calling this directly (instead of via `Button::isr()` or the virtual `pressed()`)
+ * only needs to save the registers actually used, not all call-clobbered ones.
+ * @param	isPressed	!=0 if physical button is currently pressed
+ * @return  `Debounce::PRESS` or `Debounce::RELEASE` if an edge was detected, else `Debounce::NONE`
+ */
+BUTTON_ALWAYS_INLINE uint8_t ButtonCore::tickInline( uint8_t isPressed )
+{
+	if (mWindow) 
+		mSinceReleased += mMillisPerTick;
+
+	uint8_t edge = CountedContact::tickInline( isPressed );
+
+	if (edge == Debounce::PRESS) {
+		holdTime = 0;	// start measuring duration
+		mPending = false;
+
+		mDouble = mWindow && (mSinceReleased < doublePressMs);
+	}
+	if (edge == Debounce::RELEASE) {
+		if (holdTime > longPressMs) {
+			// long press (pressed for more than 1000ms) ?
+			if (cLongPress < UINT8_MAX) cLongPress++;			
+			BUTTON_TRACE( TRACE_LONG, (Contact*)this );
+		} else if (mDouble) {
+			// double press (this start less than 200ms after previous end)?
+			if (cDoublePress < UINT8_MAX) cDoublePress++;
+			BUTTON_TRACE( TRACE_DOUBLE, (Contact*)this );
+		} else {
+			// might be a double click, wait and see
+			mPending = true;
+			BUTTON_TRACE( TRACE_PENDING, (Contact*)this );
+		}
+		mDouble = false;
+		mWindow = true;
+		mSinceReleased = 0;
+	}
+	if (isDown && (holdTime < UINT16_MAX-mMillisPerTick))
+		holdTime += mMillisPerTick;
+	if (mWindow && (mSinceReleased > doublePressMs)) {
+		mWindow = false;
+		if (mPending) {
+			//it's not a double click
+			mPending = false;
+			if (cShortPress < UINT8_MAX) cShortPress++;			
+			BUTTON_TRACE( TRACE_SHORT, (Contact*)this );
+		}
+	}
+	return edge;
+}
+
+
+/// @brief Debounce a contact attached to a pin, state only
+class ContactPin : public Contact {
+	private:
+		uint8_t				mMask;
+		volatile uint8_t	*mPort;
 		
-		volatile bool		isDown;			///< true if button is currently pressed.
-		volatile uint8_t	cPressed;		///< count # of times debounced button was pressed, can be reset by application.
-		volatile uint8_t	cReleased;		///< count # of times debounced button was released, can be reset by application.
-		volatile uint16_t	holdTime;		///< duration of current button press, in ms.
-		volatile uint8_t	cShortPress;	///< count # of short presses detected, can be reset by application
-		volatile uint8_t	cLongPress;		///< count # of long presses detected, can be reset by application
-		volatile uint8_t	cDoublePress;   ///< count # of double clicks detected, can be reset by application
+	public:
+		ContactPin(volatile uint8_t* port, uint8_t bit) : Contact() { init(port,bit); }
+		void init(volatile uint8_t* port, uint8_t bit) { mPort = port; mMask = 1 << bit; Contact::init(); }
+		bool pressed() { return (*mPort & mMask) != 0; }
+		void tick() { tickInline( pressed() ); }
+		static void isr(void* arg) { ((ContactPin*)arg)->tick(); }
 };
 
 
@@ -83,4 +306,4 @@ class ButtonPin : public Button {
 
 /** @} */
 
-#endif /* BUTTON_H_ */
\ No newline at end of file
+#endif /* BUTTON_H_ */
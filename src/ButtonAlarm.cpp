@@ -0,0 +1,124 @@
+/**
+ * @file 		  ButtonAlarm.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Zone aggregation over debounced contact masks, armed state and alarms.
+ *
+ * e.g. 12 window contacts in a group, zone 0 = ground floor, zone 1 = first floor:
+ *
+ *		GroupButton windows[12];
+ *		ButtonGroup group( windows, 12 );
+ *		AlarmZones zones;
+ *
+ *		zones.add( 0x003F );
+ *		zones.add( 0x0FC0 );
+ *		// in the tick ISR:
+ *		group.tick( ~PIND );
+ *		zones.tick( group.downMask );
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#ifdef __AVR__
+ #include <util/atomic.h>
+#else
+ // no tick ISR to block: call tick() and these functions from the same thread
+ #define ATOMIC_BLOCK(type)
+#endif
+
+#include "ButtonAlarm.h"
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief Forget all zones.
+void AlarmZones::init()
+{
+	mCount = 0;
+	open = armed = changed = alarm = tamper = 0;
+}
+
+
+/**
+ * @brief Add a zone, before the tick ISR is enabled. Zones may overlap.
+ *
+ * @param contacts	bit i set if contact i belongs to the zone
+ * @return	false if BUTTON_ALARM_ZONES zones already added
+ */
+bool AlarmZones::add( ButtonMask contacts )
+{
+	if (mCount >= BUTTON_ALARM_ZONES) return false;
+	mContacts[mCount++] = contacts;
+	return true;
+}
+
+
+/**
+ * @brief Arm zones. A zone that is open can't be armed, it would alarm at once.
+ *
+ * @param zones		zones to arm
+ * @return	zones that were not armed because they are open
+ */
+ZoneMask AlarmZones::arm( ZoneMask zones )
+{
+	ZoneMask refused;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		refused = zones & open;
+		armed |= zones & ~refused;
+	}
+	return refused;
+}
+
+
+/**
+ * @brief Disarm zones and clear their alarms and tamper bits.
+ * A tamper bit is set again on the next tick if the contact is still cut or shorted.
+ * @param zones		zones to disarm
+ */
+void AlarmZones::disarm( ZoneMask zones )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		armed &= ~zones;
+		alarm &= ~zones;
+		tamper &= ~zones;
+	}
+}
+
+
+/**
+ * @brief Get and clear the zones that opened or closed since the last call.
+ * @return	zones whose `open` bit changed
+ */
+ZoneMask AlarmZones::takeChanged()
+{
+	ZoneMask m;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		m = changed;
+		changed = 0;
+	}
+	return m;
+}
+
+
+/** @} */
@@ -0,0 +1,115 @@
+/**
+ * @file          ButtonAlarm.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_ALARM_H_
+#define BUTTON_ALARM_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_ALARM_ZONES		max # of zones, determines the width of `ZoneMask`: 8 or 16, default 8
+*/
+#ifndef BUTTON_ALARM_ZONES
+ #define BUTTON_ALARM_ZONES 8
+#endif
+
+#if BUTTON_ALARM_ZONES <= 8
+ typedef uint8_t ZoneMask;		///< one bit per zone
+#elif BUTTON_ALARM_ZONES <= 16
+ typedef uint16_t ZoneMask;
+#else
+ #error "BUTTON_ALARM_ZONES must be 16 or less"
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Zones of contacts, evaluated on debounced contact states with bitwise operations.
+ *
+ * Each zone is a `ButtonMask` of contacts, e.g. of a `ButtonGroup`. A zone is open
+ * while any of its contacts is down, i.e. open for a window contact wired that way.
+ * `tick()` takes the debounced states of all contacts as one mask, e.g.
+ * `ButtonGroup::downMask`, and costs one AND and compare per zone, however many
+ * contacts there are. A zone that opens while armed sets its bit in `alarm`.
+ *
+ * Supervised EOL contacts (`ZoneInput`) can also be cut or shorted. Pass those as
+ * `tampered`, e.g. `ZoneScanner::tamperMask`: a zone with a tampered contact counts
+ * as open, since its contact can't be seen, and sets its bit in `tamper`, armed or not.
+ */
+class AlarmZones {
+	private:
+		ButtonMask			mContacts[BUTTON_ALARM_ZONES];
+		uint8_t				mCount;
+
+	public:
+		AlarmZones() { init(); }
+		void init();
+		bool add( ButtonMask contacts );
+
+		BUTTON_ALWAYS_INLINE ZoneMask tick( ButtonMask down, ButtonMask tampered=0 );
+
+		ZoneMask arm( ZoneMask zones );
+		void disarm( ZoneMask zones );
+		ZoneMask takeChanged();
+
+		BUTTON_SHARED(ZoneMask)	open;		///< bit z set while zone z is open
+		BUTTON_SHARED(ZoneMask)	armed;		///< bit z set while zone z is armed, see `arm()`
+		BUTTON_SHARED(ZoneMask)	changed;	///< bit z set when zone z opened or closed, see `takeChanged()`
+		BUTTON_SHARED(ZoneMask)	alarm;		///< bit z set when zone z opened while armed, cleared by `disarm()`
+		BUTTON_SHARED(ZoneMask)	tamper;		///< bit z set when a contact of zone z was cut or shorted, cleared by `disarm()`
+};
+
+
+/**
+ * @brief Evaluate all zones, call from the tick ISR after the contacts were debounced.
+ * @param down		bit i set if contact i is down
+ * @param tampered	bit i set if contact i is cut or shorted
+ * @return	zones that opened or closed in this tick
+ */
+BUTTON_ALWAYS_INLINE ZoneMask AlarmZones::tick( ButtonMask down, ButtonMask tampered )
+{
+	ZoneMask now = 0;
+	down |= tampered;
+	for (uint8_t z=mCount; z--; )
+		now = (ZoneMask)(now << 1) | ((down & mContacts[z]) ? 1 : 0);
+
+	if (tampered) {
+		ZoneMask bad = 0;
+		for (uint8_t z=mCount; z--; )
+			bad = (ZoneMask)(bad << 1) | ((tampered & mContacts[z]) ? 1 : 0);
+		tamper |= bad;
+	}
+
+	ZoneMask diff = now ^ open;
+	if (diff) {
+		open = now;
+		changed |= diff;
+		alarm |= diff & now & armed;
+	}
+	return diff;
+}
+
+
+/** @} */
+
+#endif /* BUTTON_ALARM_H_ */
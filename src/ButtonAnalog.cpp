@@ -0,0 +1,120 @@
+/**
+ * @file 		  ButtonAnalog.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Analog contact inputs, one ADC shared round-robin.
+ *
+ * e.g. two window contacts on long cables, pressed (closed) below 1.5 V, released above 2 V:
+ *
+ *		AnalogScanner scanner;
+ *		AnalogButton window1, window2;
+ *
+ *		window1.init( 0, 300, 400, true );
+ *		window2.init( 1, 300, 400, true );
+ *		scanner.begin( _BV(REFS0), _BV(ADPS2) | _BV(ADPS1) );
+ *		scanner.add( &window1 );
+ *		scanner.add( &window2 );
+ *		// then call scanner.tick() every 10 ms
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#ifdef __AVR__
+ #include <avr/io.h>
+#endif
+
+#include "ButtonAnalog.h"
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Forget all inputs, without touching the ADC.
+ * @param msPerTick		interval between calls to `tick()` or `next()` [ms]
+ */
+void AnalogScanner::init( uint8_t msPerTick )
+{
+	mCount = 0;
+	mCurrent = 0;
+	mMillisPerTick = msPerTick;
+	mBusy = false;
+}
+
+
+#ifdef __AVR__
+/**
+ * @brief Enable the ADC, forget all inputs.
+ *
+ * @param refs			reference selection bits for ADMUX, e.g. `_BV(REFS0)` for AVcc
+ * @param prescaler		ADC clock prescaler bits for ADCSRA, ADC clock should be 50-200 kHz
+ * @param msPerTick		interval between calls to `tick()` [ms]
+ */
+void AnalogScanner::begin( uint8_t refs, uint8_t prescaler, uint8_t msPerTick )
+{
+	init( msPerTick );
+	mRefs = refs;
+	ADCSRA = _BV(ADEN) | (prescaler & 7);
+}
+#endif
+
+
+/**
+ * @brief Add an input, before the tick ISR is enabled.
+ * Sets the time per tick of all inputs to N ticks, for N inputs.
+ *
+ * @param input		initialized input
+ * @return	false if BUTTON_ANALOG_MAX inputs already added, or N ticks exceed 255 ms
+ */
+bool AnalogScanner::add( AnalogButton* input )
+{
+	if (mCount >= BUTTON_ANALOG_MAX) return false;
+	uint16_t ms = (uint16_t)(mCount+1) * mMillisPerTick;
+	if (ms > UINT8_MAX) return false;
+
+	mInputs[mCount++] = input;
+	for (uint8_t i=0; i<mCount; i++)
+		mInputs[i]->setMillisPerTick( (uint8_t)ms );
+	return true;
+}
+
+
+#ifdef __AVR__
+/**
+ * @brief Read the previous conversion, start the next one, call from the tick ISR.
+ */
+void AnalogScanner::tick()
+{
+	if (!mCount) return;
+	uint8_t ch = channel();
+	if (mBusy) {
+		// conversion takes ~100 us, long done unless ticks come faster than that
+		if (ADCSRA & _BV(ADSC)) return;
+		ch = next( ADC );
+	}
+	ADMUX = mRefs | (ch & 0x0F);
+	ADCSRA |= _BV(ADSC);
+	mBusy = true;
+}
+#endif
+
+
+/** @} */
@@ -0,0 +1,136 @@
+/**
+ * @file          ButtonAnalog.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_ANALOG_H_
+#define BUTTON_ANALOG_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_ANALOG_MAX		max # of analog inputs on one scanner, default 8
+*/
+#ifndef BUTTON_ANALOG_MAX
+ #define BUTTON_ANALOG_MAX 8
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Software Schmitt trigger: turn ADC readings into a binary level.
+ * The level goes to 1 at or above `high`, to 0 at or below `low`, and stays in between,
+ * so noise and slow drift smaller than `high - low` cause no edges.
+ */
+struct SchmittTrigger {
+	uint16_t	low;			///< threshold for level 0
+	uint16_t	high;			///< threshold for level 1
+	uint8_t		level;			///< current output
+
+	void init( uint16_t lo, uint16_t hi ) { low = lo; high = hi; level = 0; }
+
+	/// @brief Take one reading, @return new level
+	uint8_t sample( uint16_t v ) {
+		if (v >= high) level = 1;
+		else if (v <= low) level = 0;
+		return level;
+	}
+};
+
+
+/**
+ * @brief A button or contact read through an ADC channel.
+ * Pressed while the reading is high, or while it is low if `activeLow`.
+ */
+class AnalogButton : public ButtonCore {
+	public:
+		SchmittTrigger	trigger;
+		uint8_t			channel;		///< ADC mux channel
+		uint8_t			activeLow;
+
+		void init( uint8_t ch, uint16_t low, uint16_t high, bool inverted=false ) {
+			ButtonCore::init();
+			channel = ch;
+			activeLow = inverted ? 1 : 0;
+			trigger.init( low, high );
+			// start out released, without an edge
+			trigger.level = activeLow;
+		}
+
+		/// @brief Debounce one ADC reading, @return same as `tickInline()`
+		BUTTON_ALWAYS_INLINE uint8_t sample( uint16_t v ) { return tickInline( trigger.sample( v ) ^ activeLow ); }
+};
+
+
+/**
+ * @brief Share the ADC among several analog inputs, one conversion per tick.
+ *
+ * Each `tick()` reads the conversion started by the previous tick, feeds it to its
+ * input, and starts the conversion for the next input, so the ADC converts while the
+ * CPU does other things and the ISR never waits for it. With N inputs, each one is
+ * sampled and debounced every N ticks, and its `holdTime` advances by N ticks' worth
+ * of ms per sample.
+ *
+ * Only `begin()` and `tick()` access the ADC registers. The rest is portable, so
+ * readings can also be fed with `next()`, e.g. from another ADC or a host test.
+ */
+class AnalogScanner {
+	private:
+		AnalogButton*		mInputs[BUTTON_ANALOG_MAX];
+		uint8_t				mCount;
+		uint8_t				mCurrent;		// input whose conversion is running
+		uint8_t				mRefs;			// reference selection bits for ADMUX
+		uint8_t				mMillisPerTick;
+		bool				mBusy;			// a conversion was started
+
+	public:
+		void init( uint8_t msPerTick = Button::MS_PER_TICK );
+		bool add( AnalogButton* input );
+#ifdef __AVR__
+		void begin( uint8_t refs, uint8_t prescaler, uint8_t msPerTick = Button::MS_PER_TICK );
+		void tick();
+#endif
+
+		/// channel of the input whose reading `next()` takes
+		uint8_t channel() const { return mInputs[mCurrent]->channel; }
+		BUTTON_ALWAYS_INLINE uint8_t next( uint16_t v );
+		uint8_t count() const { return mCount; }
+};
+
+
+/**
+ * @brief Feed the reading of the current input, go on to the next one.
+ * Call only after an input was added.
+ *
+ * @param v		ADC reading of `channel()`
+ * @return	channel to convert next
+ */
+BUTTON_ALWAYS_INLINE uint8_t AnalogScanner::next( uint16_t v )
+{
+	mInputs[mCurrent]->sample( v );
+	if (++mCurrent >= mCount) mCurrent = 0;
+	return mInputs[mCurrent]->channel;
+}
+
+
+/** @} */
+
+#endif /* BUTTON_ANALOG_H_ */
@@ -0,0 +1,185 @@
+/**
+ * @file          ButtonAwait.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_AWAIT_H_
+#define BUTTON_AWAIT_H_
+
+/*
+	Host builds only, C++20, with build flag BUTTON_EVENTS: gesture handlers written
+	as coroutines, e.g.
+
+		ButtonTask onDouble( AwaitButton b ) {
+			for (;;) {
+				co_await b.next( ButtonAwait::Event::DoublePress );
+				...
+			}
+		}
+
+	Handlers are resumed by `buttonEvents.dispatch()`, i.e. in the thread that ticks
+	the buttons and dispatches their events.
+*/
+
+#ifndef BUTTON_EVENTS
+ #error "ButtonAwait.h needs build flag BUTTON_EVENTS"
+#endif
+
+#include <coroutine>
+#include <exception>
+
+#include "Button.h"
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Coroutine type for event handlers: starts at once, runs until it returns,
+ * then frees its frame. The frame is allocated once per handler, not per event.
+ */
+struct ButtonTask {
+	struct promise_type {
+		ButtonTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+
+/**
+ * @brief Waiting coroutines, per button and event kind, resumed from the event queue.
+ *
+ * Each wait is an awaiter object in the frame of the waiting coroutine, linked into
+ * a FIFO list for its button and event kind. An event takes the whole list for its
+ * button and kind and resumes the waiters in order, so the cost of an event is one
+ * resume per waiter that matches, and no memory is allocated. A handler that waits
+ * again while being resumed goes on the new list, i.e. waits for the next event.
+ *
+ * A coroutine must not be destroyed while it waits.
+ */
+class ButtonAwait {
+	public:
+		/// event kinds, same values as `ButtonTraceEvent`
+		enum class Event : uint8_t {
+			Press = TRACE_PRESS,
+			Release = TRACE_RELEASE,
+			Pending = TRACE_PENDING,
+			ShortPress = TRACE_SHORT,
+			LongPress = TRACE_LONG,
+			DoublePress = TRACE_DOUBLE,
+			Invalid = 0xFF		///< the button could not be added to `buttonEvents`, nothing to wait for
+		};
+
+		/// `co_await` this to wait for the next event of a kind on a button.
+		/// For a button index of 0xFF, or an event that is not a kind, e.g. `Event::Invalid`,
+		/// it completes at once with `Event::Invalid`.
+		struct Awaiter {
+			uint8_t					button;
+			uint8_t					event;
+			Awaiter*				next;
+			std::coroutine_handle<>	handle;
+
+			/// true if there is a list to wait on
+			bool valid() const noexcept { return button < BUTTON_GROUP_SIZE && event < BUTTON_EVENT_KINDS; }
+
+			bool await_ready() const noexcept { return !valid(); }
+			void await_suspend( std::coroutine_handle<> h ) noexcept { handle = h; instance().enqueue( this ); }
+			Event await_resume() const noexcept { return valid() ? (Event)event : Event::Invalid; }
+		};
+
+		/// the one instance, subscribes to `buttonEvents` on first use
+		static ButtonAwait& instance() {
+			static ButtonAwait a;
+			return a;
+		}
+
+		/// # of coroutines currently waiting
+		unsigned long waiting() const { return mWaiting; }
+
+	private:
+		struct List {
+			Awaiter*	head;
+			Awaiter**	tail;
+		};
+		List				mLists[BUTTON_GROUP_SIZE][BUTTON_EVENT_KINDS];
+		unsigned long		mWaiting;
+
+		ButtonAwait() : mWaiting(0) {
+			for (auto& row : mLists)
+				for (auto& l : row) { l.head = nullptr; l.tail = &l.head; }
+			buttonEvents.subscribe( onEvent, 0xFF, (ButtonMask)~0 );
+		}
+
+		void enqueue( Awaiter* a ) {
+			List& l = mLists[a->button][a->event];
+			a->next = nullptr;
+			*l.tail = a;
+			l.tail = &a->next;
+			mWaiting++;
+		}
+
+		static void onEvent( uint8_t event, uint8_t button ) {
+			if (button >= BUTTON_GROUP_SIZE || event >= BUTTON_EVENT_KINDS) return;
+			ButtonAwait& self = instance();
+			List& l = self.mLists[button][event];
+			Awaiter* a = l.head;
+			l.head = nullptr;
+			l.tail = &l.head;
+			while (a) {
+				// resuming may end the coroutine and free the awaiter
+				Awaiter* next = a->next;
+				self.mWaiting--;
+				a->handle.resume();
+				a = next;
+			}
+		}
+};
+
+
+/**
+ * @brief Handle for one button, as registered with `buttonEvents`. Cheap to copy.
+ *
+ * At most BUTTON_GROUP_SIZE buttons can be added to `buttonEvents`. For any
+ * further button, `index()` is 0xFF and `co_await next()` returns
+ * `Event::Invalid` at once, so a handler must check the result, or
+ * `index()`, before it loops on it.
+ */
+class AwaitButton {
+	private:
+		uint8_t		mIndex;
+
+	public:
+		/// register `b` as event source, at most BUTTON_GROUP_SIZE buttons
+		explicit AwaitButton( Contact* b ) : mIndex( buttonEvents.add( b ) ) { ButtonAwait::instance(); }
+
+		/// index in `buttonEvents`, 0xFF if too many buttons
+		uint8_t index() const { return mIndex; }
+
+		/// wait for the next event of kind `ev` on this button
+		ButtonAwait::Awaiter next( ButtonAwait::Event ev ) const {
+			return ButtonAwait::Awaiter{ mIndex, (uint8_t)ev, nullptr, {} };
+		}
+};
+
+
+/** @} */
+
+#endif /* BUTTON_AWAIT_H_ */
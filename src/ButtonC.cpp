@@ -0,0 +1,175 @@
+/**
+ * @file 		  ButtonC.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief C interface to `ButtonCore` and `ButtonGroup`.
+ *
+ * Each function is a thin wrapper around the C++ method, `button_tick()` costs the
+ * same as `ButtonCore::tick(uint8_t)`. `ButtonCore` has no vtable, so a `button_t`
+ * is 2 bytes smaller than a `Button`.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#ifdef __AVR__
+ #include <util/atomic.h>
+#else
+ // no tick ISR to block: call the tick and these functions from the same thread
+ #define ATOMIC_BLOCK(type)
+#endif
+
+#include "ButtonGroup.h"
+#include "ButtonC.h"
+
+// same size, so arrays of members have the same stride in C and C++
+static_assert( sizeof(ButtonCore) == sizeof(button_t), "button_t size differs, check build flags" );
+static_assert( sizeof(GroupButton) == sizeof(group_button_t), "group_button_t size differs, check build flags" );
+static_assert( sizeof(ButtonGroup) == sizeof(button_group_t), "button_group_t size differs, check build flags" );
+static_assert( alignof(ButtonCore) <= alignof(button_t), "button_t alignment too small" );
+static_assert( alignof(GroupButton) <= alignof(group_button_t), "group_button_t alignment too small" );
+static_assert( alignof(ButtonGroup) <= alignof(button_group_t), "button_group_t alignment too small" );
+static_assert( sizeof(ButtonMask) == sizeof(button_mask_t), "BUTTON_GROUP_SIZE differs" );
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief Take one gesture from the counters, long before double before short.
+static uint8_t takeEvent( BUTTON_SHARED(uint8_t)& cShort, BUTTON_SHARED(uint8_t)& cLong, BUTTON_SHARED(uint8_t)& cDouble )
+{
+	uint8_t ev = BUTTON_NONE;
+
+	// the counters are incremented by the tick ISR
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (cLong) {
+			cLong--;
+			ev = BUTTON_LONG;
+		} else if (cDouble) {
+			cDouble--;
+			ev = BUTTON_DOUBLE;
+		} else if (cShort) {
+			cShort--;
+			ev = BUTTON_SHORT;
+		}
+	}
+	return ev;
+}
+
+
+/// @brief Initialize button, with default timing.
+void button_init( button_t* b )
+{
+	((ButtonCore*)b)->init();
+}
+
+
+/// @brief Set # of ms between calls to `button_tick()`, default 10.
+void button_set_ms_per_tick( button_t* b, uint8_t ms )
+{
+	((ButtonCore*)b)->setMillisPerTick( ms );
+}
+
+
+/**
+ * @brief Do debouncing and gesture detection, e.g. from a timer ISR.
+ * @param	is_pressed	!=0 if physical button is currently pressed
+ * @return  BUTTON_EDGE_PRESS or BUTTON_EDGE_RELEASE if an edge was detected, else BUTTON_EDGE_NONE
+ */
+uint8_t button_tick( button_t* b, uint8_t is_pressed )
+{
+	return ((ButtonCore*)b)->tickInline( is_pressed );
+}
+
+
+/// @brief !=0 if button is currently pressed, debounced.
+uint8_t button_is_down( const button_t* b )
+{
+	return ((const ButtonCore*)b)->isDown;
+}
+
+
+/// @brief Duration of current button press, or of the last one if released, in ms.
+uint16_t button_hold_time( const button_t* b )
+{
+	uint16_t t;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { t = ((const ButtonCore*)b)->holdTime; }
+	return t;
+}
+
+
+/**
+ * @brief Take the next gesture detected since the last call.
+ * Gestures that happened since the last call are not returned in order.
+ * @return BUTTON_SHORT, BUTTON_LONG, BUTTON_DOUBLE, or BUTTON_NONE
+ */
+uint8_t button_event( button_t* b )
+{
+	ButtonCore* pb = (ButtonCore*)b;
+	return takeEvent( pb->cShortPress, pb->cLongPress, pb->cDoublePress );
+}
+
+
+/**
+ * @brief Initialize a group of buttons.
+ * @param members	array of buttons, static storage
+ * @param count		# of buttons in the array, max. BUTTON_GROUP_SIZE
+ */
+void button_group_init( button_group_t* g, group_button_t* members, uint8_t count )
+{
+	((ButtonGroup*)g)->init( (GroupButton*)members, count );
+}
+
+
+/**
+ * @brief Advance group clock and debounce all buttons, e.g. from a timer ISR.
+ * @param is_pressed	bit i !=0 if physical button i is currently pressed
+ */
+void button_group_tick( button_group_t* g, button_mask_t is_pressed )
+{
+	((ButtonGroup*)g)->tick( is_pressed );
+}
+
+
+/// @brief !=0 if button `i` of the group is currently pressed, debounced.
+uint8_t button_group_is_down( const button_group_t* g, uint8_t i )
+{
+	return (*(const ButtonGroup*)g)[i].isDown;
+}
+
+
+/// @brief Duration of current press of button `i`, or of the last one if released, in ms.
+uint16_t button_group_hold_time( const button_group_t* g, uint8_t i )
+{
+	uint16_t t;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { t = ((const ButtonGroup*)g)->holdTime( i ); }
+	return t;
+}
+
+
+/// @brief Take the next gesture of button `i`, same as `button_event()`.
+uint8_t button_group_event( button_group_t* g, uint8_t i )
+{
+	GroupButton& b = (*(ButtonGroup*)g)[i];
+	return takeEvent( b.cShortPress, b.cLongPress, b.cDoublePress );
+}
+
+
+/**@}*/
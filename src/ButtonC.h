@@ -0,0 +1,117 @@
+/**
+ * @file          ButtonC.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_C_H_
+#define BUTTON_C_H_
+
+/*
+	C interface to `ButtonCore` and `ButtonGroup`, for firmware written in plain C.
+	Objects are opaque types of exactly the size and at least the alignment of the
+	C++ objects, so arrays of them have the same stride. Declare them with static
+	storage, so they start out zeroed. Use the same build flags for C and C++ files,
+	sizes and alignment are checked when compiling ButtonC.cpp.
+*/
+
+#include <stdint.h>
+
+#ifdef BUTTON_BOUNCE_STATS
+ #define BUTTON_C_STATS 2
+#else
+ #define BUTTON_C_STATS 0
+#endif
+#ifdef BUTTON_EVENTS
+ #define BUTTON_C_EVENTS 1
+#else
+ #define BUTTON_C_EVENTS 0
+#endif
+#ifndef BUTTON_WHEEL_SIZE
+ #define BUTTON_WHEEL_SIZE 32
+#endif
+#ifndef BUTTON_GROUP_SIZE
+ #define BUTTON_GROUP_SIZE 16
+#endif
+
+#if BUTTON_GROUP_SIZE <= 8
+ typedef uint8_t button_mask_t;		/* one bit per button in a group */
+#elif BUTTON_GROUP_SIZE <= 16
+ typedef uint16_t button_mask_t;
+#else
+ typedef uint32_t button_mask_t;
+#endif
+
+/* sizes of the C++ objects: no padding on AVR, elsewhere uint16_t is 2-byte aligned */
+#define BUTTON_C_GROUP_FIELDS	(sizeof(void*) + 4 + BUTTON_WHEEL_SIZE + sizeof(button_mask_t))
+#ifdef __AVR__
+ #define BUTTON_C_CORE_SIZE		(15 + BUTTON_C_STATS + BUTTON_C_EVENTS)
+ #define BUTTON_C_MEMBER_SIZE	(19 + BUTTON_C_STATS + BUTTON_C_EVENTS)
+ #define BUTTON_C_GROUP_SIZE	BUTTON_C_GROUP_FIELDS
+#else
+ #define BUTTON_C_CORE_SIZE		(16 + BUTTON_C_STATS + 2*BUTTON_C_EVENTS)
+ #define BUTTON_C_MEMBER_SIZE	(20 + BUTTON_C_STATS + 2*BUTTON_C_EVENTS)
+ #define BUTTON_C_GROUP_SIZE	((BUTTON_C_GROUP_FIELDS + sizeof(void*)-1) / sizeof(void*) * sizeof(void*))
+#endif
+
+/* return values of button_tick() */
+#define BUTTON_EDGE_NONE	0
+#define BUTTON_EDGE_PRESS	1
+#define BUTTON_EDGE_RELEASE	2
+
+/* return values of button_event() */
+#define BUTTON_NONE			0
+#define BUTTON_SHORT		1
+#define BUTTON_LONG			2
+#define BUTTON_DOUBLE		3
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+/* the `align_` member gives each type the alignment of the C++ object */
+
+/** a `ButtonCore` */
+typedef union { uint16_t align_; uint8_t opaque_[BUTTON_C_CORE_SIZE]; } button_t;
+/** a `GroupButton` */
+typedef union { uint16_t align_; uint8_t opaque_[BUTTON_C_MEMBER_SIZE]; } group_button_t;
+/** a `ButtonGroup` */
+typedef union { void* align_; uint8_t opaque_[BUTTON_C_GROUP_SIZE]; } button_group_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void		button_init( button_t* b );
+void		button_set_ms_per_tick( button_t* b, uint8_t ms );
+uint8_t		button_tick( button_t* b, uint8_t is_pressed );
+uint8_t		button_is_down( const button_t* b );
+uint16_t	button_hold_time( const button_t* b );
+uint8_t		button_event( button_t* b );
+
+void		button_group_init( button_group_t* g, group_button_t* members, uint8_t count );
+void		button_group_tick( button_group_t* g, button_mask_t is_pressed );
+uint8_t		button_group_is_down( const button_group_t* g, uint8_t i );
+uint16_t	button_group_hold_time( const button_group_t* g, uint8_t i );
+uint8_t		button_group_event( button_group_t* g, uint8_t i );
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* BUTTON_C_H_ */
@@ -0,0 +1,251 @@
+/**
+ * @file 		  ButtonCapture.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Edge timestamps from Timer1 input capture, debounced by minimum level duration.
+ *
+ * e.g. for a reed switch on a meter, with F_CPU = 8 MHz and prescaler 64, i.e. 125 counts per ms,
+ * and 5 ms minimum level duration:
+ *
+ *		CaptureButton meter;
+ *		meter.begin( _BV(CS11) | _BV(CS10), 125, 5*125, true );
+ */
+
+#ifdef BUTTON_CAPTURE
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ButtonCapture.h"
+
+CaptureButton* CaptureButton::instance;
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// raw level of the ICP1 pin
+uint8_t CaptureButton::level() const
+{
+	return (BUTTON_CAPTURE_PIN >> BUTTON_CAPTURE_BIT) & 1;
+}
+
+
+/**
+ * @brief Extend a Timer1 value to 32 bits, call with interrupts disabled.
+ * An overflow that happened before `t` was taken may not have been counted yet.
+ */
+uint32_t CaptureButton::extend( uint16_t t ) const
+{
+	uint16_t hi = mOverflows;
+	if ((TIFR1 & _BV(TOV1)) && (t < 0x8000)) hi++;
+	return ((uint32_t)hi << 16) | t;
+}
+
+
+/**
+ * @brief Let the gesture logic catch up to timestamp `t`, the level has not changed.
+ * `accept()` accounts for the ms of the edge in advance, so `t` may be up to one ms
+ * before `mSync`. Any other `t` is after it, by up to 2^32 counts: a longer time
+ * without wakeup only happens while idle, when the missing time does not matter.
+ */
+void CaptureButton::sync( uint32_t t )
+{
+	if ((uint32_t)(mSync - t) <= mTicksPerMs) return;
+	uint32_t dt = t - mSync;
+	if (dt < mTicksPerMs) return;
+	uint32_t ms = dt / mTicksPerMs;
+	skipMillis( ms );
+	mSync += ms * mTicksPerMs;
+}
+
+
+/**
+ * @brief Program compare B for the next time the gesture logic needs attention, if any.
+ * @param now	current Timer1 value
+ */
+void CaptureButton::schedule( uint16_t now )
+{
+	uint16_t ms = nextWakeupTicks();
+	if (ms == NO_WAKEUP) {
+		TIMSK1 &= ~_BV(OCIE1B);
+		return;
+	}
+	// a longer wait than one timer period wakes up early, and schedules again
+	uint32_t d = (uint32_t)ms * mTicksPerMs;
+	OCR1B = now + ((d > 0xFFFF) ? 0xFFFF : (uint16_t)d);
+	TIFR1 = _BV(OCF1B);
+	TIMSK1 |= _BV(OCIE1B);
+}
+
+
+/**
+ * @brief Feed an accepted edge to the gesture logic.
+ * The debounce history is set up so that one tick produces the edge, then set to stable.
+ *
+ * @param pressed	new debounced state
+ * @param t			timestamp of the edge
+ */
+void CaptureButton::accept( uint8_t pressed, uint32_t t )
+{
+	sync( t );
+	mState = pressed ? (Debounce::RISE >> 1) : (Debounce::FALL >> 1);
+	tickInline( pressed );
+	mState = pressed ? Debounce::MASK : 0;
+	mSync = t + mTicksPerMs;
+
+	if (pressed) {
+		if (mHavePress) period = t - mLastPress;
+		mLastPress = t;
+		mHavePress = true;
+	} else {
+		width = t - lastEdge;
+	}
+	lastEdge = t;
+	schedule( TCNT1 );
+}
+
+
+/**
+ * @brief Set up Timer1 for input capture and take over its interrupts.
+ * Timer1 runs freely from now on, so it can't be used for anything else.
+ *
+ * @param prescaler		clock select bits for TCCR1B, e.g. `_BV(CS11) | _BV(CS10)` for F_CPU/64
+ * @param ticksPerMs	Timer1 counts per ms at that prescaler
+ * @param minTicks		min. time [Timer1 counts] a level must hold to be accepted,
+ *						at least a few hundred CPU cycles
+ * @param activeLow		true if the pin is low while pressed
+ */
+void CaptureButton::begin( uint8_t prescaler, uint16_t ticksPerMs, uint16_t minTicks, bool activeLow )
+{
+	instance = this;
+	ButtonCore::init();
+	setMillisPerTick( 1 );
+	mTicksPerMs = ticksPerMs ? ticksPerMs : 1;
+	mMinTicks = minTicks;
+	mActiveLow = activeLow;
+	mBouncing = false;
+	mHavePress = false;
+	mSync = 0;
+	lastEdge = period = width = 0;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		uint8_t l = level();
+		mState = (l ^ (activeLow ? 1 : 0)) ? Debounce::MASK : 0;
+		isDown = (mState != 0);
+		mOverflows = 0;
+		TCCR1A = 0;
+		// noise canceler on, wait for the edge away from the current level
+		TCCR1B = _BV(ICNC1) | (l ? 0 : _BV(ICES1)) | (prescaler & 7);
+		TCNT1 = 0;
+		TIFR1 = _BV(ICF1) | _BV(OCF1A) | _BV(OCF1B) | _BV(TOV1);
+		TIMSK1 = _BV(ICIE1) | _BV(TOIE1);
+	}
+}
+
+
+/// @brief Bring `holdTime` and short press detection up to date, call before reading them.
+void CaptureButton::update()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		// during a burst, the level may already have changed at mFirst
+		sync( mBouncing ? mFirst : extend( TCNT1 ) );
+	}
+}
+
+
+/**
+ * @brief Called from the capture ISR: an edge on the pin.
+ * @param icr	captured Timer1 value
+ */
+void CaptureButton::onCapture( uint16_t icr )
+{
+	uint32_t t = extend( icr );
+
+	// wait for the edge away from the level now on the pin; changing the edge may set ICF1
+	if (level()) TCCR1B &= ~_BV(ICES1); else TCCR1B |= _BV(ICES1);
+	TIFR1 = _BV(ICF1);
+#ifdef BUTTON_BOUNCE_STATS
+	if (cRawEdges < UINT16_MAX) cRawEdges++;
+#endif
+
+	if (!mBouncing) {
+		mFirst = t;
+		mBouncing = true;
+	}
+	OCR1A = icr + mMinTicks;
+	TIFR1 = _BV(OCF1A);
+	TIMSK1 |= _BV(OCIE1A);
+}
+
+
+/// @brief Called from the compare A ISR: no edge for `minTicks`, the level is stable.
+void CaptureButton::onSettled()
+{
+	TIMSK1 &= ~_BV(OCIE1A);
+	mBouncing = false;
+
+	// an edge may have been missed between capture and reading the pin
+	uint8_t l = level();
+	if (l) TCCR1B &= ~_BV(ICES1); else TCCR1B |= _BV(ICES1);
+
+	uint8_t pressed = l ^ (mActiveLow ? 1 : 0);
+	if (pressed != (isDown ? 1 : 0))
+		accept( pressed, mFirst );
+}
+
+
+/// @brief Called from the compare B ISR: the double-press window may have closed.
+void CaptureButton::onTimeout()
+{
+	uint16_t now = TCNT1;
+	sync( mBouncing ? mFirst : extend( now ) );
+	schedule( now );
+}
+
+
+ISR(TIMER1_CAPT_vect)
+{
+	CaptureButton::instance->onCapture( ICR1 );
+}
+
+ISR(TIMER1_COMPA_vect)
+{
+	CaptureButton::instance->onSettled();
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+	CaptureButton::instance->onTimeout();
+}
+
+ISR(TIMER1_OVF_vect)
+{
+	CaptureButton::instance->onOverflow();
+}
+
+
+/** @} */
+
+#endif /* BUTTON_CAPTURE */
@@ -0,0 +1,100 @@
+/**
+ * @file          ButtonCapture.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_CAPTURE_H_
+#define BUTTON_CAPTURE_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_CAPTURE			compile the input capture source, it owns Timer1 and its capture,
+							compare A, compare B and overflow interrupt vectors
+	BUTTON_CAPTURE_PIN		input register of the ICP1 pin, default PINB (ATmega328P)
+	BUTTON_CAPTURE_BIT		bit of the ICP1 pin, default 0
+*/
+
+#ifndef BUTTON_CAPTURE_PIN
+ #define BUTTON_CAPTURE_PIN PINB
+#endif
+#ifndef BUTTON_CAPTURE_BIT
+ #define BUTTON_CAPTURE_BIT 0
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief A button or pulse input on the ICP1 pin, timestamped by Timer1 input capture.
+ *
+ * Nothing is polled. Each edge on the pin is captured by the hardware and costs one
+ * short ISR, which re-arms compare A for `minTicks` later. Any further edge before
+ * that restarts the wait, so compare A only fires once the level has held for
+ * `minTicks`. If that level differs from the debounced one, the edge is accepted,
+ * with the timestamp of the first edge of the burst, i.e. accurate to one Timer1 count
+ * instead of one tick.
+ *
+ * Accepted edges drive the same gesture logic as `Button`, at 1 ms per tick: time
+ * between edges is accounted with `skipMillis()`, in constant time. A short press is
+ * only known once the double-press window has passed, so a release arms compare B
+ * for the end of the window. Timestamps are extended to 32 bits by the overflow ISR.
+ *
+ * `holdTime` is updated at edges only, call `update()` before reading it while the
+ * button is held. The 32-bit fields must be read with interrupts disabled.
+ */
+class CaptureButton : public ButtonCore {
+	private:
+		volatile uint16_t	mOverflows;		// high word of timestamps
+		uint32_t			mFirst;			// timestamp of first edge of the current burst
+		bool				mBouncing;		// edges seen since the level last held for mMinTicks
+		bool				mActiveLow;
+		bool				mHavePress;		// mLastPress is valid
+		uint32_t			mSync;			// gesture logic has accounted for time up to here
+		uint32_t			mLastPress;
+		uint16_t			mTicksPerMs;
+		uint16_t			mMinTicks;
+
+		uint8_t level() const;
+		uint32_t extend( uint16_t t ) const;
+		void sync( uint32_t t );
+		void accept( uint8_t pressed, uint32_t t );
+		void schedule( uint16_t now );
+
+	public:
+		void begin( uint8_t prescaler, uint16_t ticksPerMs, uint16_t minTicks, bool activeLow );
+		void update();
+
+		void onCapture( uint16_t icr );
+		void onSettled();
+		void onTimeout();
+		void onOverflow() { mOverflows++; }
+
+		volatile uint32_t	lastEdge;		///< Timer1 timestamp of the last accepted edge
+		volatile uint32_t	period;			///< Timer1 counts between the last two accepted presses, 0 if unknown
+		volatile uint32_t	width;			///< Timer1 counts of the last complete press
+
+		static CaptureButton* instance;
+};
+
+
+/** @} */
+
+#endif /* BUTTON_CAPTURE_H_ */
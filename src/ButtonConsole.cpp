@@ -0,0 +1,266 @@
+/**
+ * @file 		  ButtonConsole.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Serial console for button statistics and runtime tuning, on USART0.
+ *
+ * Can be tried out in simavr, whose UART model connects USART0 to a pty.
+ */
+
+#ifdef BUTTON_CONSOLE
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ButtonConsole.h"
+
+ButtonConsole* ButtonConsole::instance;
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief Start measuring, call at start of ISR.
+void IsrBudget::begin()
+{
+	mStart = TCNT1;
+}
+
+
+/// @brief Stop measuring, call at end of ISR.
+void IsrBudget::end()
+{
+	uint16_t d = TCNT1 - mStart;
+	last = d;
+	if (d > max) max = d;
+}
+
+
+/**
+ * @brief Initialize USART0 for 8N1, enable receive interrupt.
+ *
+ * @param baud	baud rate, e.g. 38400
+ */
+void ButtonConsole::begin( uint32_t baud )
+{
+	instance = this;
+	mCount = 0;
+	mTxHead = mTxTail = 0;
+	mRxLen = 0;
+	mRxReady = false;
+
+	uint16_t ubrr = (F_CPU / 8 + baud / 2) / baud - 1;
+	UBRR0H = ubrr >> 8;
+	UBRR0L = ubrr & 0xFF;
+	UCSR0A = _BV(U2X0);
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+	UCSR0B = _BV(RXEN0) | _BV(TXEN0) | _BV(RXCIE0);
+}
+
+
+/**
+ * @brief Add a button to the list of buttons to report on.
+ *
+ * @param button	pointer to button
+ * @return	false if list is full
+ */
+bool ButtonConsole::add( Button* button )
+{
+	if (mCount >= BUTTON_CONSOLE_MAX) return false;
+	mButtons[mCount++] = button;
+	return true;
+}
+
+
+/// @brief Queue one character for sending, drop it if buffer is full.
+void ButtonConsole::print( char c )
+{
+	uint8_t h = mTxHead;
+	if ((uint8_t)(h - mTxTail) >= BUTTON_CONSOLE_TXSIZE) return;
+	mTx[h & (BUTTON_CONSOLE_TXSIZE-1)] = c;
+	mTxHead = h+1;
+	UCSR0B |= _BV(UDRIE0);
+}
+
+
+void ButtonConsole::print( const char* s )
+{
+	while (*s) print( *s++ );
+}
+
+
+void ButtonConsole::print( uint16_t u )
+{
+	char buf[6];
+	uint8_t i = 0;
+	do { buf[i++] = '0' + u % 10; u /= 10; } while (u);
+	while (i) print( buf[--i] );
+}
+
+
+/// @brief Called from USART data register empty ISR: send next character.
+void ButtonConsole::onTxEmpty()
+{
+	uint8_t t = mTxTail;
+	if (t == mTxHead) {
+		UCSR0B &= ~_BV(UDRIE0);
+		return;
+	}
+	UDR0 = mTx[t & (BUTTON_CONSOLE_TXSIZE-1)];
+	mTxTail = t+1;
+}
+
+
+/// @brief Called from USART receive ISR: collect characters of a command line.
+void ButtonConsole::onRx( char c )
+{
+	if (mRxReady) return;			// previous line not yet executed, drop
+	if (c == '\r' || c == '\n') {
+		if (mRxLen) {
+			mRx[mRxLen] = 0;
+			mRxReady = true;
+		}
+	} else if (mRxLen < BUTTON_CONSOLE_RXSIZE-1) {
+		mRx[mRxLen++] = c;
+	}
+}
+
+
+/**
+ * @brief Execute a received command line, if any. Call from the main loop.
+ */
+void ButtonConsole::poll()
+{
+	if (!mRxReady) return;
+	execute( mRx );
+	mRxLen = 0;
+	mRxReady = false;
+}
+
+
+/// @brief Parse and execute a command line.
+void ButtonConsole::execute( const char* line )
+{
+	const char* p = line+1;
+	uint16_t arg = 0;
+	bool hasArg = false;
+	while (*p == ' ') p++;
+	while (*p >= '0' && *p <= '9') {
+		arg = arg*10 + (*p++ - '0');
+		hasArg = true;
+	}
+
+	switch (line[0]) {
+		case 's':	showButtons();	break;
+		case 'c':	showBudget();	break;
+		case 'z':	reset();		break;
+#ifdef BUTTON_RUNTIME_THRESHOLDS
+		// 16-bit values are also read by the tick ISR
+		case 'l':
+			if (hasArg) ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Button::setLongPress( arg ); }
+			showThresholds();
+			break;
+		case 'd':
+			if (hasArg) ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Button::setDoublePress( arg ); }
+			showThresholds();
+			break;
+#endif
+		default:	print( "?\r\n" );	break;
+	}
+}
+
+
+/// @brief One line per button: index, state and counters.
+void ButtonConsole::showButtons()
+{
+	for (uint8_t i=0; i<mCount; i++) {
+		Button* b = mButtons[i];
+		print( '#' );		print( (uint16_t)i );
+		print( " down=" );	print( (uint16_t)b->isDown );
+		print( " P=" );		print( (uint16_t)b->cPressed );
+		print( " R=" );		print( (uint16_t)b->cReleased );
+		print( " S=" );		print( (uint16_t)b->cShortPress );
+		print( " L=" );		print( (uint16_t)b->cLongPress );
+		print( " D=" );		print( (uint16_t)b->cDoublePress );
+#ifdef BUTTON_BOUNCE_STATS
+		// raw edges per debounced edge, above 1 means the contact bounces
+		uint16_t raw;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { raw = b->cRawEdges; }
+		print( " raw=" );	print( raw );
+#endif
+		print( "\r\n" );
+	}
+	showThresholds();
+}
+
+
+void ButtonConsole::showThresholds()
+{
+	print( "long=" );	print( Button::longPressMs );
+	print( " double=" );	print( Button::doublePressMs );
+	print( "\r\n" );
+}
+
+
+void ButtonConsole::showBudget()
+{
+	uint16_t last, max;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { last = budget.last; max = budget.max; }
+	print( "isr last=" );	print( last );
+	print( " max=" );		print( max );
+	print( "\r\n" );
+}
+
+
+void ButtonConsole::reset()
+{
+	for (uint8_t i=0; i<mCount; i++) {
+		Button* b = mButtons[i];
+		b->cPressed = b->cReleased = 0;
+		b->cShortPress = b->cLongPress = b->cDoublePress = 0;
+#ifdef BUTTON_BOUNCE_STATS
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { b->cRawEdges = 0; }
+#endif
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { budget.max = 0; }
+	print( "ok\r\n" );
+}
+
+
+ISR(USART_UDRE_vect)
+{
+	ButtonConsole::instance->onTxEmpty();
+}
+
+
+ISR(USART_RX_vect)
+{
+	char c = UDR0;
+	ButtonConsole::instance->onRx( c );
+}
+
+
+/**@}*/
+
+#endif // BUTTON_CONSOLE
@@ -0,0 +1,116 @@
+/**
+ * @file          ButtonConsole.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_CONSOLE_H_
+#define BUTTON_CONSOLE_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_CONSOLE				compile the console, it owns the USART0 interrupt vectors,
+								so it cannot be used together with Arduino's `Serial`
+	BUTTON_CONSOLE_MAX			max # of buttons to report on, default 8
+	BUTTON_CONSOLE_TXSIZE		size of transmit buffer, power of 2, default 64
+	BUTTON_RUNTIME_THRESHOLDS	needed for the `l` and `d` commands
+	BUTTON_BOUNCE_STATS			needed to report raw edge counts
+*/
+
+#ifndef BUTTON_CONSOLE_MAX
+ #define BUTTON_CONSOLE_MAX 8
+#endif
+#ifndef BUTTON_CONSOLE_TXSIZE
+ #define BUTTON_CONSOLE_TXSIZE 64
+#endif
+#define BUTTON_CONSOLE_RXSIZE 16
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Measure the duration of an ISR, in Timer1 counts.
+ * Call `begin()` at the start and `end()` at the end of the ISR.
+ * Timer1 must be running, with prescaler 1 the result is in CPU cycles.
+ */
+struct IsrBudget {
+	volatile uint16_t	last;		///< duration of most recent ISR
+	volatile uint16_t	max;		///< longest duration seen, can be reset by application
+	uint16_t			mStart;
+
+	void begin();
+	void end();
+};
+
+
+/**
+ * @brief Non-blocking serial console for statistics and tuning.
+ *
+ * Output is buffered and sent from the USART data register empty interrupt.
+ * When the buffer is full, output is dropped rather than waited for, so the
+ * console can never stall the debounce ISR or the main loop.
+ * Received characters are collected by the USART receive interrupt,
+ * and a complete line is executed by `poll()`, called from the main loop.
+ *
+ * Commands, terminated by CR or LF:
+ * - `s`		show state, counters and raw edge counts of all buttons
+ * - `c`		show ISR budget
+ * - `z`		reset all counters and ISR budget maximum
+ * - `l <ms>`	set minimum long press duration
+ * - `d <ms>`	set max double click separation
+ */
+class ButtonConsole {
+	private:
+		Button*				mButtons[BUTTON_CONSOLE_MAX];
+		uint8_t				mCount;
+		char				mTx[BUTTON_CONSOLE_TXSIZE];
+		volatile uint8_t	mTxHead;
+		volatile uint8_t	mTxTail;
+		char				mRx[BUTTON_CONSOLE_RXSIZE];
+		volatile uint8_t	mRxLen;
+		volatile bool		mRxReady;
+
+		void execute( const char* line );
+		void showButtons();
+		void showBudget();
+		void showThresholds();
+		void reset();
+
+	public:
+		IsrBudget			budget;		///< to be updated by the application's tick ISR
+
+		void begin( uint32_t baud );
+		bool add( Button* button );
+		void poll();
+
+		void print( char c );
+		void print( const char* s );
+		void print( uint16_t u );
+
+		void onTxEmpty();
+		void onRx( char c );
+
+		static ButtonConsole* instance;
+};
+
+
+/** @} */
+
+#endif /* BUTTON_CONSOLE_H_ */
@@ -0,0 +1,205 @@
+/**
+ * @file          ButtonDebounce.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2019,2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_DEBOUNCE_H_
+#define BUTTON_DEBOUNCE_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+
+#include "ButtonTrace.h"
+
+/// force inlining of the time-critical path, so an ISR only saves the registers it really uses
+#define BUTTON_ALWAYS_INLINE	inline __attribute__((always_inline))
+
+/// level must be steady for this many ticks
+#ifndef BUTTON_NTICKS
+ #define BUTTON_NTICKS 3
+#endif
+// the sample history of N+1 ticks must fit in a byte
+#if BUTTON_NTICKS < 1 || BUTTON_NTICKS > 7
+ #error "BUTTON_NTICKS must be 1..7"
+#endif
+
+/// max # of buttons in a group, determines the width of `ButtonMask`: 8, 16 or 32
+#ifndef BUTTON_GROUP_SIZE
+ #define BUTTON_GROUP_SIZE 16
+#endif
+
+#if BUTTON_GROUP_SIZE > 32
+ #error "BUTTON_GROUP_SIZE must be at most 32"
+#endif
+
+#if BUTTON_GROUP_SIZE <= 8
+ typedef uint8_t ButtonMask;		///< one bit per button in a group or event source set
+#elif BUTTON_GROUP_SIZE <= 16
+ typedef uint16_t ButtonMask;
+#else
+ typedef uint32_t ButtonMask;
+#endif
+
+/*
+	Build flag BUTTON_ATOMIC, for host builds with reader threads: fields shared with
+	other threads are relaxed `std::atomic`s instead of `volatile`, see `SharedVar`.
+*/
+#ifdef BUTTON_ATOMIC
+ #include <atomic>
+ #define BUTTON_SHARED(T)	SharedVar<T>
+#else
+ #define BUTTON_SHARED(T)	volatile T
+#endif
+
+/*
+	Build flags to select the implementation of the debounce core:
+	BUTTON_DEBOUNCE_TABLE	transition table in flash, generated at compile time
+	(default)				portable C++
+*/
+#ifdef BUTTON_DEBOUNCE_TABLE
+ #if BUTTON_NTICKS > 5
+  #error "BUTTON_DEBOUNCE_TABLE supports BUTTON_NTICKS up to 5"
+ #endif
+ #ifdef __AVR__
+  #include <avr/pgmspace.h>
+ #else
+  #define PROGMEM
+  #define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+ #endif
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+#ifdef BUTTON_ATOMIC
+/**
+ * @brief A field written by the tick thread and read by others.
+ * Loads and stores are relaxed atomics, i.e. plain moves on x86 and ARM, so readers
+ * never see torn values. There is only one writer, so increments are a load plus a
+ * store, not a locked read-modify-write. Ordering between fields is not guaranteed,
+ * use `SharedButton` for a consistent snapshot.
+ */
+template <typename T>
+class SharedVar {
+	private:
+		std::atomic<T>	v;
+
+	public:
+		SharedVar() : v(0) {}
+		operator T() const { return v.load( std::memory_order_relaxed ); }
+		SharedVar& operator=( T x ) { v.store( x, std::memory_order_relaxed ); return *this; }
+		SharedVar& operator=( const SharedVar& o ) { return *this = (T)o; }
+		SharedVar& operator+=( T d ) { return *this = (T)(*this + d); }
+		SharedVar& operator|=( T m ) { return *this = (T)(*this | m); }
+		SharedVar& operator&=( T m ) { return *this = (T)(*this & m); }
+		T operator++( int ) { T x = *this; *this = (T)(x+1); return x; }
+};
+#endif
+
+
+/**
+ * @brief The debounce core: sample the input, detect stable edges.
+ *
+ * The debounce logic samples the state of the button input multiple times
+ * and accumulates samples in a variable (max 8 samples).
+ * A valid keypress is a pattern of 1x not pressed, then N times pressed,
+ * e.g. 0,1,1,1 for N=3
+ * A valid key release is a pattern of 1x pressed, then N times not pressed,
+ * e.g. 1,0,0,0 for N=3
+ */
+struct Debounce {
+	/// how many samples to look at
+	static const uint8_t	MASK = (1 << (BUTTON_NTICKS+1))-1;
+	/// expected pattern at start of keypress
+	static const uint8_t	RISE = (1 << BUTTON_NTICKS)-1;
+	/// expected pattern at end of keypress
+	static const uint8_t	FALL = MASK & ~RISE;
+
+	/// result of `step()`
+	enum Edge { NONE=0, PRESS=1, RELEASE=2 };
+
+	static BUTTON_ALWAYS_INLINE uint8_t step( uint8_t& state, uint8_t isPressed );
+
+	/// true if the last N+1 samples were all the same, so no edge can come without an input change
+	static bool stable( uint8_t state ) { state &= MASK; return (state == 0) || (state == MASK); }
+
+	/// # of entries in the transition table: (N+1) bits of history plus 1 new sample.
+	/// 512 for N=7, so it does not fit in a byte.
+	static const uint16_t	TABLE_SIZE = 2*(MASK+1);
+	/**
+	 * @brief Transition table entry for index `(state << 1) | sample`: 
+	 * next state in bits 0..5, edge in bits 6..7
+	 */
+	static constexpr uint8_t entry( uint8_t i ) {
+		return (i & MASK) 
+			| ( (i & MASK)==RISE ? (PRESS << 6) : (i & MASK)==FALL ? (RELEASE << 6) : (NONE << 6) );
+	}
+};
+
+
+#ifdef BUTTON_DEBOUNCE_TABLE
+
+/// @brief Transition table in flash, with one entry for each index in I...
+template<uint8_t... I> struct DebounceTable {
+	static const uint8_t data[sizeof...(I)] PROGMEM;
+};
+
+template<uint8_t... I> 
+const uint8_t DebounceTable<I...>::data[sizeof...(I)] PROGMEM = { Debounce::entry(I)... };
+
+/// @brief Generate `DebounceTable<0,1,...,N-1>`, to regenerate when BUTTON_NTICKS changes
+template<uint8_t N, uint8_t... I> 
+struct DebounceTableGen : DebounceTableGen<N-1, N-1, I...> {};
+
+template<uint8_t... I> 
+struct DebounceTableGen<0, I...> { typedef DebounceTable<I...> type; };
+
+#endif // BUTTON_DEBOUNCE_TABLE
+
+
+/**
+ * @brief Shift in one sample, report if a stable edge has been detected.
+ *
+ * @param state		sample history, owned by the caller
+ * @param isPressed	!=0 if physical button is currently pressed
+ * @return  one of `Debounce::NONE`, `Debounce::PRESS` or `Debounce::RELEASE`
+ */
+BUTTON_ALWAYS_INLINE uint8_t Debounce::step( uint8_t& state, uint8_t isPressed )
+{
+#if defined(BUTTON_DEBOUNCE_TABLE)
+	// one lookup does shift, mask and pattern match
+	uint8_t t = pgm_read_byte( 
+		&DebounceTableGen<TABLE_SIZE>::type::data[ ((uint8_t)(state << 1) | (isPressed ? 1 : 0)) & (TABLE_SIZE-1) ] );
+	state = t & MASK;
+	return t >> 6;
+#else
+	uint8_t s = (uint8_t)(state << 1) | (isPressed ? 1 : 0);
+	state = s;
+    // just pressed? look for e.g. [na na na na 0 1 1 1] pattern
+	if ((s & MASK) == RISE) return PRESS;
+    // just released? look for e.g. [na na na na 1 0 0 0] pattern
+	if ((s & MASK) == FALL) return RELEASE;
+	return NONE;
+#endif
+}
+
+
+/** @} */
+
+#endif /* BUTTON_DEBOUNCE_H_ */
@@ -0,0 +1,108 @@
+/**
+ * @file 		  ButtonEvents.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Event queue and dispatch to listeners, filtered by event kind and button.
+ */
+
+#ifdef BUTTON_EVENTS
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "Button.h"
+
+/// the event queue, all buttons report here
+ButtonEvents buttonEvents;
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Register a button as event source. Do this before the tick ISR is enabled.
+ * Group members are added the same way, via `&group[i]`. The index is kept in the
+ * button, so `post()` needs no search. Adding a button again returns the same index.
+ *
+ * @param button	pointer to button
+ * @return	index of the button in events and masks, 0xFF if BUTTON_GROUP_SIZE buttons already added
+ */
+uint8_t ButtonEvents::add( Contact* button )
+{
+	if (button->mEventSource) return button->mEventSource-1;
+	if (mSourceCount >= BUTTON_GROUP_SIZE) return 0xFF;
+	button->mEventSource = mSourceCount+1;
+	mSources[mSourceCount] = button;
+	return mSourceCount++;
+}
+
+
+/**
+ * @brief Add a listener.
+ *
+ * @param handler	function to call
+ * @param events	event kinds to call it for, e.g. `BUTTON_GESTURES` or `BUTTON_EVENT_BIT(TRACE_LONG)`
+ * @param buttons	bit i set: call it for events of button i
+ * @return	false if BUTTON_EVENT_LISTENERS listeners already subscribed
+ */
+bool ButtonEvents::subscribe( ButtonEventHandler handler, uint8_t events, ButtonMask buttons )
+{
+	if (mListenerCount >= BUTTON_EVENT_LISTENERS) return false;
+	uint8_t n = mListenerCount++;
+	ListenerMask bit = (ListenerMask)1 << n;
+
+	mHandlers[n] = handler;
+	for (uint8_t ev=0; ev<BUTTON_EVENT_KINDS; ev++)
+		if (events & BUTTON_EVENT_BIT(ev)) mByEvent[ev] |= bit;
+	for (uint8_t i=0; i<BUTTON_GROUP_SIZE; i++, buttons >>= 1)
+		if (buttons & 1) mByButton[i] |= bit;
+	return true;
+}
+
+
+/**
+ * @brief Call the listeners for all queued events. Call from the main loop.
+ *
+ * @return	# of events taken from the queue
+ */
+uint8_t ButtonEvents::dispatch()
+{
+	uint8_t n = 0;
+	uint8_t t = mTail;
+
+	while (t != mHead) {
+		Entry e = mQueue[t & (BUTTON_EVENT_QUEUE-1)];
+		mTail = ++t;
+		n++;
+		ListenerMask m = mByEvent[e.event] & mByButton[e.button];
+		while (m) {
+			uint8_t k = __builtin_ctz( m );
+			m &= m-1;
+			mHandlers[k]( e.event, e.button );
+		}
+	}
+	return n;
+}
+
+
+/**@}*/
+
+#endif // BUTTON_EVENTS
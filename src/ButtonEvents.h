@@ -0,0 +1,130 @@
+/**
+ * @file          ButtonEvents.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_EVENTS_H_
+#define BUTTON_EVENTS_H_
+
+#include "ButtonDebounce.h"
+
+/*
+	Build flags:
+	BUTTON_EVENTS				queue events in `buttonEvents`, uses the `BUTTON_TRACE` hook,
+								so it can't be combined with a trace backend
+	BUTTON_EVENT_QUEUE			# of queued events, power of 2, default 16
+	BUTTON_EVENT_LISTENERS		max # of listeners, up to 16, default 8
+*/
+
+#ifndef BUTTON_EVENT_QUEUE
+ #define BUTTON_EVENT_QUEUE 16
+#endif
+#ifndef BUTTON_EVENT_LISTENERS
+ #define BUTTON_EVENT_LISTENERS 8
+#endif
+#if BUTTON_EVENT_LISTENERS > 16
+ #error "BUTTON_EVENT_LISTENERS must be at most 16"
+#endif
+
+#if BUTTON_EVENT_LISTENERS <= 8
+ typedef uint8_t ListenerMask;		///< one bit per listener
+#else
+ typedef uint16_t ListenerMask;
+#endif
+
+/// bit for event `ev` (a `ButtonTraceEvent`) in an event mask
+#define BUTTON_EVENT_BIT(ev)	(1 << (ev))
+/// event mask for all gestures
+#define BUTTON_GESTURES			(BUTTON_EVENT_BIT(TRACE_SHORT) | BUTTON_EVENT_BIT(TRACE_LONG) | BUTTON_EVENT_BIT(TRACE_DOUBLE))
+/// # of event kinds
+#define BUTTON_EVENT_KINDS		(TRACE_DOUBLE+1)
+
+class Contact;
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Event handler
+ * @param event		a `ButtonTraceEvent`
+ * @param button	index of the button, in the order of `add()`
+ */
+typedef void (*ButtonEventHandler)( uint8_t event, uint8_t button );
+
+
+/**
+ * @brief Deferred event dispatch, instead of polling counters.
+ *
+ * The tick ISR reports events via `post()`, they are queued and handed to the
+ * subscribed listeners by `dispatch()`, in the order they happened, from the main loop.
+ * Each listener subscribes to a set of event kinds and a set of buttons. The listeners
+ * for an event are found by and-ing two listener masks, one for the event kind and
+ * one for the button, so dispatch takes time only for the listeners that match.
+ */
+class ButtonEvents {
+	private:
+		struct Entry {
+			uint8_t			event;
+			uint8_t			button;
+		};
+		Entry				mQueue[BUTTON_EVENT_QUEUE];
+		volatile uint8_t	mHead;
+		volatile uint8_t	mTail;
+		const Contact*		mSources[BUTTON_GROUP_SIZE];	// for lookups from the main loop
+		uint8_t				mSourceCount;
+		ButtonEventHandler	mHandlers[BUTTON_EVENT_LISTENERS];
+		uint8_t				mListenerCount;
+		ListenerMask		mByEvent[BUTTON_EVENT_KINDS];	// listeners per event kind
+		ListenerMask		mByButton[BUTTON_GROUP_SIZE];	// listeners per button
+
+	public:
+		volatile uint8_t	cDropped;	///< count # of events lost because queue was full
+
+		uint8_t add( Contact* button );
+		bool subscribe( ButtonEventHandler handler, uint8_t events, ButtonMask buttons );
+		uint8_t dispatch();
+
+		/// the button with index `i`, nullptr if not added
+		const Contact* source( uint8_t i ) const { return (i < mSourceCount) ? mSources[i] : nullptr; }
+
+		/**
+		 * @brief Queue an event, called from the tick ISR. Events of buttons not added are ignored.
+		 * @param source	`Contact::eventSource()` of the button, index+1 or 0
+		 */
+		BUTTON_ALWAYS_INLINE void post( uint8_t event, uint8_t source ) {
+			if (!source) return;
+
+			uint8_t h = mHead;
+			if ((uint8_t)(h - mTail) >= BUTTON_EVENT_QUEUE) {
+				if (cDropped < UINT8_MAX) cDropped++;
+				return;
+			}
+			Entry& e = mQueue[h & (BUTTON_EVENT_QUEUE-1)];
+			e.event = event;
+			e.button = source-1;
+			mHead = h+1;
+		}
+};
+
+extern ButtonEvents buttonEvents;
+
+
+/** @} */
+
+#endif /* BUTTON_EVENTS_H_ */
@@ -0,0 +1,379 @@
+/**
+ * @file 		  ButtonGroup.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Debounce a group of buttons, with a timing wheel for gesture timeouts.
+ *
+ * Gestures are the same as for class `Button`, but all timing is done in ticks of
+ * the group clock. A button has at most one deadline at any time:
+ * - while pressed: long-press threshold reached, later: `holdTime` saturated
+ * - while released: end of the double-press window, which turns a pending press
+ *   into a short press
+ *
+ * The wheel has BUTTON_WHEEL_SIZE slots, one per tick. Deadlines further away
+ * than that wait for some full turns of the wheel.
+ *
+ * Differences to `Button`: `holdTime` is computed on demand, via `holdTime(i)`.
+ * A short press whose double-press window was about to expire is still counted
+ * if the next press starts in that very tick, `Button` drops it.
+ * A spike shorter than BUTTON_NTICKS while released gives a release edge without
+ * a prior press. Both count it in `cReleased`, but the group ignores it for gestures,
+ * while `Button` takes it as the end of a press, and counts a gesture for it.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+
+#include "ButtonGroup.h"
+
+// mFlags bits
+#define F_PENDING	0x01	// released, might still become a double click
+#define F_WINDOW	0x02	// double-press window is open
+#define F_DOUBLE	0x04	// this press started within double-press window
+#define F_LONG		0x08	// pressed for longer than MIN_LONG_PRESS
+#define F_HOLDMAX	0x10	// pressed for longer than holdTime can represent
+#define F_DOWN		0x20	// a press has been seen, so a release is a gesture
+
+// mSlot value for "not on the wheel"
+#define NO_SLOT		0xFF
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Define the members of the group.
+ *
+ * Only the first BUTTON_GROUP_SIZE buttons are used, since each needs a bit in
+ * `ButtonMask`. Check `count()` if the array may be larger.
+ *
+ * @param members	array of buttons, owned by the application
+ * @param count		# of buttons in the array, max. BUTTON_GROUP_SIZE
+ */
+void ButtonGroup::init( GroupButton* members, uint8_t count )
+{
+	if (count > BUTTON_GROUP_SIZE) count = BUTTON_GROUP_SIZE;
+	mMembers = members;
+	mCount = count;
+	mMillisPerTick = Button::MS_PER_TICK;
+	mNow = 0;
+	downMask = 0;
+	memset( mWheel, 0, sizeof(mWheel) );
+	for (uint8_t i=0; i<count; i++) {
+		GroupButton& b = members[i];
+		b.Contact::init();
+		b.mHoldTime = 0;
+		b.mFlags = 0;
+		b.mNext = b.mPrev = 0;
+		b.mSlot = NO_SLOT;
+	}
+}
+
+
+/**
+ * @brief Put button on the wheel, to expire `ticks` ticks from now.
+ *
+ * @param i		index of button
+ * @param ticks	delay, >0
+ */
+void ButtonGroup::schedule( uint8_t i, uint16_t ticks )
+{
+	GroupButton& b = mMembers[i];
+	uint8_t slot = (uint8_t)(mNow + ticks) & (BUTTON_WHEEL_SIZE-1);
+
+	b.mRounds = (ticks-1) / BUTTON_WHEEL_SIZE;
+	b.mSlot = slot;
+	b.mPrev = 0;
+	b.mNext = mWheel[slot];
+	if (b.mNext) mMembers[b.mNext-1].mPrev = i+1;
+	mWheel[slot] = i+1;
+}
+
+
+/// @brief Take button off the wheel, if it is on it.
+void ButtonGroup::unschedule( uint8_t i )
+{
+	GroupButton& b = mMembers[i];
+	if (b.mSlot == NO_SLOT) return;
+
+	if (b.mPrev)
+		mMembers[b.mPrev-1].mNext = b.mNext;
+	else
+		mWheel[b.mSlot] = b.mNext;
+	if (b.mNext) mMembers[b.mNext-1].mPrev = b.mPrev;
+	b.mSlot = NO_SLOT;
+}
+
+
+/// @brief Deadline of button `i` has been reached.
+void ButtonGroup::expire( uint8_t i )
+{
+	GroupButton& b = mMembers[i];
+
+	if (b.isDown) {
+		if (b.mFlags & F_LONG) {
+			b.mFlags |= F_HOLDMAX;
+		} else {
+			b.mFlags |= F_LONG;
+			// next deadline: when holdTime would saturate
+			schedule( i, UINT16_MAX / mMillisPerTick - Button::longPressMs / mMillisPerTick );
+		}
+	} else {
+		if (b.mFlags & F_PENDING) {
+			//it's not a double click
+			if (b.cShortPress < UINT8_MAX) b.cShortPress++;
+			BUTTON_TRACE( TRACE_SHORT, (Contact*)&b );
+		}
+		b.mFlags = 0;
+	}
+}
+
+
+/**
+ * @brief Time since button was pressed, plus `extra` ticks, in ms, saturated.
+ * Widened before adding, so a press of 65535 ticks does not wrap to 0.
+ */
+uint16_t ButtonGroup::heldMs( const GroupButton& b, uint8_t extra ) const
+{
+	uint32_t t = ((uint32_t)(uint16_t)(mNow - b.mPressedAt) + extra) * mMillisPerTick;
+	return (t > UINT16_MAX) ? UINT16_MAX : (uint16_t)t;
+}
+
+
+/// @brief Button `i` has just been pressed.
+void ButtonGroup::onPress( uint8_t i )
+{
+	GroupButton& b = mMembers[i];
+	uint8_t flags = 0;
+
+	unschedule( i );
+	if (b.mFlags & F_WINDOW) {
+		// double press (this start less than 200ms after previous end)?
+		if ((uint16_t)(mNow - b.mReleasedAt) * mMillisPerTick < Button::doublePressMs)
+			flags = F_DOUBLE;
+		else if (b.mFlags & F_PENDING) {
+			if (b.cShortPress < UINT8_MAX) b.cShortPress++;
+			BUTTON_TRACE( TRACE_SHORT, (Contact*)&b );
+		}
+	}
+	b.mFlags = flags | F_DOWN;
+	b.mPressedAt = mNow;
+	schedule( i, Button::longPressMs / mMillisPerTick + 1 );
+}
+
+
+/// @brief Button `i` has just been released.
+void ButtonGroup::onRelease( uint8_t i )
+{
+	GroupButton& b = mMembers[i];
+	uint8_t flags = F_WINDOW;
+
+	// a spike shorter than BUTTON_NTICKS looks like a release, without a press
+	if (!(b.mFlags & F_DOWN)) return;
+	unschedule( i );
+	b.mHoldTime = (b.mFlags & F_HOLDMAX) ? UINT16_MAX : heldMs( b, 0 );
+	if (b.mFlags & F_LONG) {
+		// long press (pressed for more than 1000ms) ?
+		if (b.cLongPress < UINT8_MAX) b.cLongPress++;
+		BUTTON_TRACE( TRACE_LONG, (Contact*)&b );
+	} else if (b.mFlags & F_DOUBLE) {
+		if (b.cDoublePress < UINT8_MAX) b.cDoublePress++;
+		BUTTON_TRACE( TRACE_DOUBLE, (Contact*)&b );
+	} else {
+		// might be a double click, wait and see
+		flags |= F_PENDING;
+		BUTTON_TRACE( TRACE_PENDING, (Contact*)&b );
+	}
+	b.mFlags = flags;
+	b.mReleasedAt = mNow;
+	schedule( i, Button::doublePressMs / mMillisPerTick + 1 );
+}
+
+
+/**
+ * @brief Advance group clock, process expired deadlines, debounce all buttons.
+ *
+ * @param isPressed		bit i !=0 if physical button i is currently pressed
+ */
+void ButtonGroup::tick( ButtonMask isPressed )
+{
+	mNow++;
+
+	// timer work: only buttons with a deadline in this slot
+	uint8_t k = mWheel[ (uint8_t)mNow & (BUTTON_WHEEL_SIZE-1) ];
+	while (k) {
+		GroupButton& b = mMembers[k-1];
+		uint8_t next = b.mNext;
+		if (b.mRounds) {
+			b.mRounds--;
+		} else {
+			unschedule( k-1 );
+			expire( k-1 );
+		}
+		k = next;
+	}
+
+	for (uint8_t i=0; i<mCount; i++) {
+		uint8_t edge = mMembers[i].tickInline( isPressed & 1 );
+		isPressed >>= 1;
+		if (edge == Debounce::PRESS) {
+			downMask |= (ButtonMask)1 << i;
+			onPress( i );
+		} else if (edge == Debounce::RELEASE) {
+			downMask &= ~((ButtonMask)1 << i);
+			onRelease( i );
+		}
+	}
+}
+
+
+/// @brief # of ticks until deadline of a button on the wheel
+uint16_t ButtonGroup::due( const GroupButton& b ) const
+{
+	uint8_t k = ((uint8_t)(b.mSlot - mNow - 1) & (BUTTON_WHEEL_SIZE-1)) + 1;
+	return k + b.mRounds * BUTTON_WHEEL_SIZE;
+}
+
+
+/// @brief Advance clock by `ticks`, which must be less than the earliest deadline.
+void ButtonGroup::skip( uint16_t ticks )
+{
+	for (uint8_t slot=0; slot<BUTTON_WHEEL_SIZE; slot++) {
+		for (uint8_t k=mWheel[slot]; k; k=mMembers[k-1].mNext) {
+			GroupButton& b = mMembers[k-1];
+			b.mRounds = (due(b) - ticks - 1) / BUTTON_WHEEL_SIZE;
+		}
+	}
+	mNow += ticks;
+}
+
+
+/**
+ * @brief Most recent raw samples of all buttons.
+ * @param busy	set to true if any button is still debouncing
+ */
+ButtonMask ButtonGroup::lastSamples( bool& busy ) const
+{
+	ButtonMask m = 0;
+	busy = false;
+	for (uint8_t i=mCount; i--; ) {
+		m = (m << 1) | mMembers[i].lastSample();
+		if (!mMembers[i].isStable()) busy = true;
+	}
+	return m;
+}
+
+
+/**
+ * @brief Earliest time the group needs attention, for tickless operation.
+ * Same contract as `Button::nextWakeupTicks()`: the earliest deadline on the
+ * wheel, or every tick while any button is still debouncing.
+ *
+ * @return # of ticks, 1 = keep ticking, `Contact::NO_WAKEUP` = only on an input change
+ */
+uint16_t ButtonGroup::nextWakeupTicks() const
+{
+	uint16_t next = Contact::NO_WAKEUP;
+
+	for (uint8_t i=0; i<mCount; i++) 
+		if (!mMembers[i].isStable()) return 1;
+	for (uint8_t slot=0; slot<BUTTON_WHEEL_SIZE; slot++) {
+		for (uint8_t k=mWheel[slot]; k; k=mMembers[k-1].mNext) {
+			uint16_t d = due( mMembers[k-1] );
+			if (d < next) next = d;
+		}
+	}
+	return next;
+}
+
+
+/**
+ * @brief Account for ticks that were skipped while sleeping, the inputs have not changed.
+ * Same result as calling `tick()` `ticks` times with the previous inputs, but only 
+ * takes time for debouncing still in progress and for deadlines on the wheel.
+ * 
+ * @param ticks	# of ticks that passed without a call to `tick()`
+ */
+void ButtonGroup::idle( uint16_t ticks )
+{
+	bool busy;
+	ButtonMask samples = lastSamples( busy );
+
+	// debouncing in progress: must really be done tick by tick
+	for ( ; ticks && busy; ticks--) {
+		tick( samples );
+		samples = lastSamples( busy );
+	}
+	while (ticks) {
+		uint16_t next = nextWakeupTicks();
+		if (next > ticks) {
+			skip( ticks );
+			break;
+		}
+		// jump to just before the deadline, then do that tick for real
+		skip( next-1 );
+		tick( samples );
+		ticks -= next;
+	}
+}
+
+
+/**
+ * @brief Account for time without ticks, e.g. while the timer was stopped in power-down.
+ * Same as `Button::skipMillis()`: the inputs are assumed not to have changed, and 
+ * anything longer than the longest deadline makes no difference.
+ * 
+ * @param ms	time skipped [ms], rounded down to whole ticks
+ */
+void ButtonGroup::skipMillis( uint32_t ms )
+{
+	const uint32_t settled = UINT16_MAX / mMillisPerTick + BUTTON_NTICKS + 2;
+	uint32_t ticks = ms / mMillisPerTick;
+
+	if (ticks > settled) ticks = settled;
+	while (ticks) {
+		uint16_t n = (ticks > UINT16_MAX) ? UINT16_MAX : (uint16_t)ticks;
+		idle( n );
+		ticks -= n;
+	}
+}
+
+
+/**
+ * @brief Duration of current button press, or of the last one if released, in ms.
+ * Same as `Button::holdTime`, but computed on demand.
+ *
+ * @param i		index of button
+ */
+uint16_t ButtonGroup::holdTime( uint8_t i ) const
+{
+	const GroupButton& b = mMembers[i];
+
+	if (!b.isDown) return b.mHoldTime;
+	if (b.mFlags & F_HOLDMAX) return UINT16_MAX;
+	return heldMs( b, 1 );
+}
+
+
+/**@}*/
@@ -0,0 +1,114 @@
+/**
+ * @file          ButtonGroup.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_GROUP_H_
+#define BUTTON_GROUP_H_
+
+#include "Button.h"
+
+/// # of slots in the timing wheel, must be a power of 2
+#ifndef BUTTON_WHEEL_SIZE
+ #define BUTTON_WHEEL_SIZE 32
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief One member of a `ButtonGroup`, same gestures as `Button`.
+ * Timing is kept by the group, so there is no per-button work on a tick,
+ * except the debouncing itself.
+ */
+class GroupButton : public CountedContact {
+	friend class ButtonGroup;
+	private:
+		uint16_t			mPressedAt;		// group tick of last press
+		uint16_t			mReleasedAt;	// group tick of last release
+		uint16_t			mHoldTime;		// hold time of last press, once released
+		uint8_t				mFlags;
+		uint8_t				mNext;			// timing wheel links: index+1, 0=none
+		uint8_t				mPrev;
+		uint8_t				mSlot;
+		uint16_t			mRounds;		// full turns of the wheel still to wait
+
+	public:
+		BUTTON_SHARED(uint8_t)	cShortPress;	///< count # of short presses detected, can be reset by application
+		BUTTON_SHARED(uint8_t)	cLongPress;		///< count # of long presses detected, can be reset by application
+		BUTTON_SHARED(uint8_t)	cDoublePress;   ///< count # of double clicks detected, can be reset by application
+};
+
+
+/**
+ * @brief A group of buttons sharing one clock and one timing wheel.
+ *
+ * `Button` updates `holdTime` and checks the double-press window on every tick,
+ * for every button. Here, a button is only put on the timing wheel while it has
+ * a deadline (end of double-press window, long-press threshold), so the timer work
+ * per tick scales with the number of active buttons, not the size of the group.
+ *
+ * Unlike `Button`, the group ignores a release without a prior press (a spike
+ * shorter than BUTTON_NTICKS while released) for gestures, it only counts it in
+ * `cReleased`. `Button` takes it as the end of a press.
+ */
+class ButtonGroup {
+	private:
+		GroupButton*		mMembers;
+		uint8_t				mCount;
+		uint8_t				mMillisPerTick;
+		uint16_t			mNow;						// in ticks
+		uint8_t				mWheel[BUTTON_WHEEL_SIZE];	// list heads: index+1, 0=empty
+
+		void schedule( uint8_t i, uint16_t ticks );
+		void unschedule( uint8_t i );
+		void expire( uint8_t i );
+		void onPress( uint8_t i );
+		void onRelease( uint8_t i );
+		uint16_t due( const GroupButton& b ) const;
+		uint16_t heldMs( const GroupButton& b, uint8_t extra ) const;
+		void skip( uint16_t ticks );
+		ButtonMask lastSamples( bool& busy ) const;
+
+	public:
+		ButtonGroup( GroupButton* members, uint8_t count ) { init( members, count ); }
+		void init( GroupButton* members, uint8_t count );
+		void setMillisPerTick(uint8_t ms) { if (ms) mMillisPerTick=ms; }
+
+		void tick( ButtonMask isPressed );
+
+		uint16_t nextWakeupTicks() const;
+		void idle( uint16_t ticks );
+		void skipMillis( uint32_t ms );
+
+		uint16_t holdTime( uint8_t i ) const;
+
+		BUTTON_SHARED(ButtonMask)	downMask;	///< bit i set while button i is pressed, updated on edges only
+
+		/// access member `i` (0-based)
+		GroupButton& operator[]( uint8_t i ) { return mMembers[i]; }
+		const GroupButton& operator[]( uint8_t i ) const { return mMembers[i]; }
+		/// # of members, at most BUTTON_GROUP_SIZE
+		uint8_t count() const { return mCount; }
+};
+
+
+/** @} */
+
+#endif /* BUTTON_GROUP_H_ */
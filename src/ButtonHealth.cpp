@@ -0,0 +1,52 @@
+/**
+ * @file 		  ButtonHealth.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Contact wear indicators, updated at the end of each bounce burst.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ButtonHealth.h"
+
+/// defaults: 2 ticks of bounce, 6 raw edges per edge, one dropout every other press
+HealthLimits ContactHealth::limits = { 2*16, 6*16, 8 };
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief Start with the averages of a new, clean contact.
+void ContactHealth::init()
+{
+	mLast = 0;
+	mBurst = false;
+	mDown = false;
+	mDropouts = 0;
+	bounceAvg = 0;
+	edgesAvg = 1*16;
+	dropoutAvg = 0;
+	needsService = false;
+}
+
+
+/** @} */
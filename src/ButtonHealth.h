@@ -0,0 +1,151 @@
+/**
+ * @file          ButtonHealth.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_HEALTH_H_
+#define BUTTON_HEALTH_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_HEALTH_SHIFT		weight of a new value in the averages is 1/2^SHIFT, default 3
+*/
+#ifndef BUTTON_HEALTH_SHIFT
+ #define BUTTON_HEALTH_SHIFT 3
+#endif
+#if BUTTON_HEALTH_SHIFT < 1 || BUTTON_HEALTH_SHIFT > 7
+ #error "BUTTON_HEALTH_SHIFT must be 1..7"
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief Limits for `ContactHealth::needsService`, same fixed point format as the averages
+struct HealthLimits {
+	uint16_t	bounce;			///< average bounce time [ticks * 16]
+	uint16_t	edges;			///< average raw edges per debounced edge [* 16]
+	uint16_t	dropouts;		///< average dropouts per press [* 16]
+};
+
+
+/**
+ * @brief Wear indicators of one contact, for predictive maintenance.
+ *
+ * A burst starts at a raw input change and ends either at the debounced edge it
+ * causes or, if the input goes back, when the contact is stable again. At the end
+ * of a burst, exponential averages are updated:
+ * - `bounceAvg`: ticks the input bounced before it settled, 0 for a clean edge
+ * - `edgesAvg`: raw edges per debounced edge, 1 for a clean edge
+ * - `dropoutAvg`: short raw releases per press, that did not end the press,
+ *   updated at the release. A release shorter than BUTTON_NTICKS shows up as a
+ *   second press edge while down, it is counted here too, not as a press.
+ *
+ * All three are fixed point with 4 fractional bits, i.e. 16 = 1.0. Worn contacts
+ * bounce longer and more often, and drop out while held. If an average exceeds
+ * its limit in `limits`, `needsService` is set and stays set until the application
+ * clears it. Outside bursts, a tick costs one compare.
+ */
+class ContactHealth {
+	private:
+		uint8_t				mLast;			// previous raw sample
+		bool				mBurst;			// raw input changed, not settled yet
+		bool				mDown;			// debounced state before the burst
+		uint8_t				mTicks;			// ticks since start of burst
+		uint8_t				mEdges;			// raw edges in this burst
+		uint8_t				mDropouts;		// dropouts in this press
+
+		static BUTTON_ALWAYS_INLINE void average( BUTTON_SHARED(uint16_t)& avg, uint8_t x, uint16_t limit, BUTTON_SHARED(bool)& flag );
+
+	public:
+		ContactHealth() { init(); }
+		void init();
+
+		BUTTON_ALWAYS_INLINE void tick( uint8_t edge, const Contact& contact );
+
+		BUTTON_SHARED(uint16_t)	bounceAvg;		///< average bounce time [ticks * 16]
+		BUTTON_SHARED(uint16_t)	edgesAvg;		///< average raw edges per debounced edge [* 16]
+		BUTTON_SHARED(uint16_t)	dropoutAvg;		///< average dropouts per press [* 16]
+		BUTTON_SHARED(bool)		needsService;	///< an average exceeded its limit, to be cleared by application
+
+		static HealthLimits		limits;			///< same for all contacts
+};
+
+
+/**
+ * @brief Add `x` to an average, check its limit.
+ * The step is rounded to nearest, so for a constant `x` the average settles within
+ * 2^(SHIFT-1) LSB of x*16, from below and from above. Truncating would leave it up
+ * to 2^SHIFT-1 LSB below a rising input.
+ */
+BUTTON_ALWAYS_INLINE void ContactHealth::average( BUTTON_SHARED(uint16_t)& avg, uint8_t x, uint16_t limit, BUTTON_SHARED(bool)& flag )
+{
+	int16_t a = (int16_t)avg;
+	a += ((int16_t)((uint16_t)x << 4) - a + (1 << (BUTTON_HEALTH_SHIFT-1))) >> BUTTON_HEALTH_SHIFT;
+	avg = (uint16_t)a;
+	if ((uint16_t)a > limit) flag = true;
+}
+
+
+/**
+ * @brief Follow raw and debounced edges, call after each tick of the contact.
+ * @param edge		result of `contact.tickInline()`
+ * @param contact	the contact, for its raw sample and state
+ */
+BUTTON_ALWAYS_INLINE void ContactHealth::tick( uint8_t edge, const Contact& contact )
+{
+	uint8_t s = contact.lastSample();
+	if (s != mLast) {
+		mLast = s;
+		if (!mBurst) {
+			mBurst = true;
+			mTicks = 0;
+			mEdges = 0;
+		}
+		if (mEdges < UINT8_MAX) mEdges++;
+	}
+	if (!mBurst) return;
+
+	if (mTicks < UINT8_MAX) mTicks++;
+	if (edge != Debounce::NONE && (edge == Debounce::PRESS) == mDown) {
+		// press while down: a dropout; release while released: a spike
+		if (mDown && mDropouts < UINT8_MAX) mDropouts++;
+		mBurst = false;
+	} else if (edge != Debounce::NONE) {
+		// the last BUTTON_NTICKS ticks of the burst were steady
+		average( bounceAvg, (mTicks > BUTTON_NTICKS) ? mTicks - BUTTON_NTICKS : 0, limits.bounce, needsService );
+		average( edgesAvg, mEdges, limits.edges, needsService );
+		if (edge == Debounce::RELEASE) {
+			average( dropoutAvg, mDropouts, limits.dropouts, needsService );
+			mDropouts = 0;
+		}
+		mDown = (edge == Debounce::PRESS);
+		mBurst = false;
+	} else if (contact.isStable()) {
+		// input went back without an edge: a dropout while held, or a spike while released
+		if (mDown && mDropouts < UINT8_MAX) mDropouts++;
+		mBurst = false;
+	}
+}
+
+
+/** @} */
+
+#endif /* BUTTON_HEALTH_H_ */
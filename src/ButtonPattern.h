@@ -0,0 +1,224 @@
+/**
+ * @file          ButtonPattern.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_PATTERN_H_
+#define BUTTON_PATTERN_H_
+
+#include "Button.h"
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif !defined(PROGMEM)
+ #define PROGMEM
+ #define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#endif
+
+/*
+	Build flags:
+	BUTTON_PATTERN_DASH		min. press duration [ms] for a dash, shorter is a dot, default 400
+	BUTTON_PATTERN_GAP		pause [ms] after the last release that ends a code, default 1000
+*/
+#ifndef BUTTON_PATTERN_DASH
+ #define BUTTON_PATTERN_DASH 400
+#endif
+#ifndef BUTTON_PATTERN_GAP
+ #define BUTTON_PATTERN_GAP 1000
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Code of a pattern string like ".-.", max 7 symbols.
+ * The symbols are the bits after the leading 1, dot=0 and dash=1, so every code
+ * is also the state of the matcher after the last symbol, and the code of a prefix
+ * is the code shifted right. A longer string has no room for the leading 1, its
+ * code is 0, which `ButtonPatterns` rejects.
+ */
+constexpr uint8_t patternCode( const char* p, uint8_t code = 1 ) {
+	return !*p ? code
+		: (code & 0x80) ? 0
+		: patternCode( p+1, (uint8_t)((code << 1) | (*p == '-' ? 1 : 0)) );
+}
+
+/// # of symbols in a code
+constexpr uint8_t patternLength( uint8_t code ) {
+	return (code > 1) ? 1 + patternLength( code >> 1 ) : 0;
+}
+
+/// true if `s` is a proper prefix of `code`
+constexpr bool patternIsPrefix( uint8_t s, uint8_t code ) {
+	return (s != 0) && (code > s) && ((code >> (patternLength(code) - patternLength(s))) == s);
+}
+
+/// smallest power of 2 above `code`
+constexpr uint16_t patternTableSize( uint8_t code, uint16_t size = 2 ) {
+	return (size > code) ? size : patternTableSize( code, size << 1 );
+}
+
+
+/// flag in a table entry: more symbols may follow
+#define PATTERN_PREFIX	0x80
+
+/**
+ * @brief Table entry for state `s`: index+1 of the pattern that ends here, or 0,
+ * plus PATTERN_PREFIX if `s` is the start of a longer pattern.
+ * An entry of 0 means no pattern can match any more.
+ */
+template<uint8_t... C> struct PatternEntry;
+
+template<> struct PatternEntry<> {
+	static constexpr uint8_t get( uint8_t, uint8_t ) { return 0; }
+	static constexpr uint8_t maxCode() { return 1; }
+	static constexpr bool valid() { return true; }
+	static constexpr bool contains( uint8_t ) { return false; }
+	static constexpr bool distinct() { return true; }
+};
+
+template<uint8_t C0, uint8_t... C> struct PatternEntry<C0, C...> {
+	static constexpr uint8_t get( uint8_t s, uint8_t n ) {
+		return (s == C0 ? n : 0) | (patternIsPrefix( s, C0 ) ? PATTERN_PREFIX : 0)
+			| PatternEntry<C...>::get( s, n+1 );
+	}
+	static constexpr uint8_t maxCode() {
+		return (C0 > PatternEntry<C...>::maxCode()) ? C0 : PatternEntry<C...>::maxCode();
+	}
+	/// all codes have 1..7 symbols
+	static constexpr bool valid() { return (C0 >= 2) && PatternEntry<C...>::valid(); }
+	static constexpr bool contains( uint8_t c ) { return (C0 == c) || PatternEntry<C...>::contains( c ); }
+	/// no code appears twice
+	static constexpr bool distinct() {
+		return !PatternEntry<C...>::contains( C0 ) && PatternEntry<C...>::distinct();
+	}
+};
+
+
+/// @brief The automaton in flash, one entry for each state in I...
+template<typename E, uint8_t... I> struct PatternTable {
+	static const uint8_t data[sizeof...(I)] PROGMEM;
+};
+
+template<typename E, uint8_t... I>
+const uint8_t PatternTable<E, I...>::data[sizeof...(I)] PROGMEM = { E::get( I, 1 )... };
+
+/// @brief Generate `PatternTable<E, 0,1,...,N-1>`
+template<typename E, uint16_t N, uint8_t... I>
+struct PatternTableGen : PatternTableGen<E, N-1, N-1, I...> {};
+
+template<typename E, uint8_t... I>
+struct PatternTableGen<E, 0, I...> { typedef PatternTable<E, I...> type; };
+
+
+/**
+ * @brief A set of patterns, compiled into an automaton at compile time, e.g.
+ *
+ *		typedef ButtonPatterns< patternCode("..-"), patternCode("-.-.") > Codes;
+ *		PatternMatcher unlock( Codes::table(), Codes::SIZE );
+ *
+ * All codes must be different, max. 127 codes.
+ */
+template<uint8_t... C> struct ButtonPatterns {
+	static_assert( PatternEntry<C...>::valid(), "pattern codes must have 1 to 7 symbols" );
+	static_assert( PatternEntry<C...>::distinct(), "pattern codes must be different" );
+	static_assert( sizeof...(C) <= 127, "max. 127 pattern codes" );
+
+	/// # of states, i.e. table entries
+	static const uint16_t SIZE = patternTableSize( PatternEntry<C...>::maxCode() );
+
+	static const uint8_t* table() { return PatternTableGen<PatternEntry<C...>, SIZE>::type::data; }
+};
+
+
+/**
+ * @brief Recognize codes of short and long presses on one button, e.g. for access codes.
+ *
+ * Each release adds one symbol, a dot or a dash depending on `holdTime`, and moves the
+ * automaton to the next state with one table lookup. The state is the code entered so far,
+ * so no history of presses is kept. A code is recognized at the release that completes
+ * it, or, if it is also the start of a longer code, when BUTTON_PATTERN_GAP ms pass
+ * without a press. After a symbol that matches no code, further presses are ignored
+ * until that pause, so a wrong code can't run into a right one.
+ */
+class PatternMatcher {
+	private:
+		const uint8_t*		mTable;			// in flash
+		uint16_t			mSize;
+		uint8_t				mState;			// 1 = no symbols yet, 0 = no match possible
+		uint8_t				mMillisPerTick;
+		uint16_t			mGap;			// ms since last release, while a code is in progress
+
+		/// entry for state `s`, 0 if outside the table
+		uint8_t entry( uint16_t s ) const { return (s < mSize) ? pgm_read_byte( &mTable[s] ) : 0; }
+
+	public:
+		/// min. press duration [ms] for a dash
+		static const uint16_t	DASH_MS = BUTTON_PATTERN_DASH;
+		/// pause [ms] that ends a code
+		static const uint16_t	GAP_MS = BUTTON_PATTERN_GAP;
+
+		PatternMatcher( const uint8_t* table, uint16_t size ) { init( table, size ); }
+		void init( const uint8_t* table, uint16_t size ) {
+			mTable = table; mSize = size; mState = 1; mGap = 0; match = 0;
+			mMillisPerTick = Button::MS_PER_TICK;
+		}
+		void setMillisPerTick( uint8_t ms ) { if (ms) mMillisPerTick = ms; }
+
+		BUTTON_ALWAYS_INLINE void tick( uint8_t edge, const ButtonCore& button );
+
+		/// true while a code is being entered
+		bool busy() const { return mState != 1; }
+
+		volatile uint8_t	match;		///< 1-based index of the last code recognized, to be cleared by application
+};
+
+
+/**
+ * @brief Advance the automaton, call after each tick of the button.
+ * @param edge		result of `button.tickInline()`
+ * @param button	the button, for `isDown` and `holdTime`
+ */
+BUTTON_ALWAYS_INLINE void PatternMatcher::tick( uint8_t edge, const ButtonCore& button )
+{
+	if (edge == Debounce::RELEASE) {
+		mGap = 0;
+		if (mState == 0) return;
+		uint16_t s = (uint16_t)(mState << 1) | (button.holdTime >= DASH_MS ? 1 : 0);
+		uint8_t e = entry( s );
+		if (e & PATTERN_PREFIX) {
+			mState = s;				// wait for more symbols, or for the pause
+		} else {
+			if (e) match = e;		// complete, and nothing longer can follow
+			mState = e ? 1 : 0;
+		}
+	} else if (mState != 1 && !button.isDown) {
+		mGap += mMillisPerTick;
+		if (mGap > GAP_MS) {
+			uint8_t e = entry( mState ) & ~PATTERN_PREFIX;
+			if (e) match = e;
+			mState = 1;
+		}
+	}
+}
+
+
+/** @} */
+
+#endif /* BUTTON_PATTERN_H_ */
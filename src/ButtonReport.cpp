@@ -0,0 +1,133 @@
+/**
+ * @file 		  ButtonReport.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Event coalescing and rate-limited reporting, in the main loop.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "Button.h"
+#include "ButtonReport.h"
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Forget all events and summaries, set timing.
+ *
+ * @param window	time to collect events of a button, from the first one [ms]
+ * @param gap		min. time between reports [ms]
+ */
+void ButtonReporter::init( uint16_t window, uint16_t gap )
+{
+	memset( mSummary, 0, sizeof(mSummary) );
+	mActive = mUrgent = 0;
+	mReported = false;
+	windowMs = window;
+	minGapMs = gap;
+	minPriorityGapMs = 0;
+	priority = 0;
+}
+
+
+/**
+ * @brief Add an event to the summary of its button.
+ * A new summary starts with the current state of the button, as registered with
+ * `buttonEvents`, so `isDown` is right even if only gestures are posted.
+ *
+ * @param event		a `ButtonTraceEvent`
+ * @param button	index of the button, less than BUTTON_GROUP_SIZE
+ * @param now		current time [ms]
+ */
+void ButtonReporter::post( uint8_t event, uint8_t button, uint32_t now )
+{
+	if (button >= BUTTON_GROUP_SIZE || event >= BUTTON_EVENT_KINDS) return;
+	ButtonReport& s = mSummary[button];
+	ButtonMask bit = (ButtonMask)1 << button;
+
+	if (!(mActive & bit)) {
+		memset( s.count, 0, sizeof(s.count) );
+		s.button = button;
+#ifdef BUTTON_EVENTS
+		const Contact* c = buttonEvents.source( button );
+		s.isDown = (c && c->isDown) ? 1 : 0;
+#endif
+		s.first = now;
+		mActive |= bit;
+	}
+	if (s.count[event] < UINT8_MAX) s.count[event]++;
+	if (event == TRACE_PRESS) s.isDown = 1;
+	else if (event == TRACE_RELEASE) s.isDown = 0;
+	s.last = now;
+	if (priority & BUTTON_EVENT_BIT(event)) mUrgent |= bit;
+}
+
+
+/**
+ * @brief Get the next report, if one is due and the rate limit allows it.
+ *
+ * @param report	receives the summary
+ * @param now		current time [ms]
+ * @return	true if `report` was filled in, and should be sent
+ */
+bool ButtonReporter::poll( ButtonReport& report, uint32_t now )
+{
+	if (!mActive) return false;
+
+	uint32_t since = now - mLastReport;
+	ButtonMask candidates;
+	if (mUrgent && (!mReported || since >= minPriorityGapMs))
+		candidates = mUrgent;
+	else if (!mReported || since >= minGapMs)
+		candidates = mActive;
+	else
+		return false;
+
+	// oldest summary whose window has passed, or any urgent one
+	int8_t best = -1;
+	uint32_t bestAge = 0;
+	for (uint8_t i=0; i<BUTTON_GROUP_SIZE; i++) {
+		ButtonMask bit = (ButtonMask)1 << i;
+		if (!(candidates & bit)) continue;
+		uint32_t age = now - mSummary[i].first;
+		if (!(mUrgent & bit) && age < windowMs) continue;
+		if (best < 0 || age > bestAge) {
+			best = i;
+			bestAge = age;
+		}
+	}
+	if (best < 0) return false;
+
+	ButtonMask bit = (ButtonMask)1 << best;
+	report = mSummary[best];
+	mActive &= ~bit;
+	mUrgent &= ~bit;
+	mLastReport = now;
+	mReported = true;
+	return true;
+}
+
+
+/** @} */
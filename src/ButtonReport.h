@@ -0,0 +1,84 @@
+/**
+ * @file          ButtonReport.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_REPORT_H_
+#define BUTTON_REPORT_H_
+
+#include "ButtonEvents.h"
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Summary of the events of one button within one coalescing window.
+ */
+struct ButtonReport {
+	uint8_t		button;						///< index of the button, as in `ButtonEvents`
+	uint8_t		isDown;						///< state when the summary started, or after the last press or release in it
+	uint8_t		count[BUTTON_EVENT_KINDS];	///< # of events per `ButtonTraceEvent`, saturating
+	uint32_t	first;						///< timestamp of the first event [ms]
+	uint32_t	last;						///< timestamp of the last event [ms]
+};
+
+
+/**
+ * @brief Coalesce button events into summaries, and limit the rate of reports, e.g. for a radio link.
+ *
+ * Events are collected per button from the first event on, for `windowMs`. Then the
+ * button's summary is due, and `poll()` hands it out, at most one report per `minGapMs`,
+ * the oldest due summary first. Events that come in while a summary waits for its turn
+ * are added to it, so a slow link sends fewer, fuller reports instead of losing events.
+ *
+ * Events of the kinds in `priority` make the summary due at once, and may be reported
+ * `minPriorityGapMs` after the previous report, e.g. 0 for an alarm contact.
+ *
+ * Everything runs in the main loop, fed from a `buttonEvents` listener:
+ *
+ *		void onButton( uint8_t event, uint8_t button ) { reporter.post( event, button, millis() ); }
+ */
+class ButtonReporter {
+	private:
+		ButtonReport		mSummary[BUTTON_GROUP_SIZE];
+		ButtonMask			mActive;		// buttons with events in mSummary
+		ButtonMask			mUrgent;		// buttons with a priority event in mSummary
+		uint32_t			mLastReport;
+		bool				mReported;		// mLastReport is valid
+
+	public:
+		uint16_t			windowMs;			///< time to collect events, from the first one
+		uint16_t			minGapMs;			///< min. time between reports
+		uint16_t			minPriorityGapMs;	///< min. time between reports, for priority events
+		uint8_t				priority;			///< event kinds that bypass the window, e.g. `BUTTON_EVENT_BIT(TRACE_PRESS)`
+
+		ButtonReporter( uint16_t window, uint16_t gap ) { init( window, gap ); }
+		void init( uint16_t window, uint16_t gap );
+
+		void post( uint8_t event, uint8_t button, uint32_t now );
+		bool poll( ButtonReport& report, uint32_t now );
+
+		/// true if any events are waiting to be reported
+		bool busy() const { return mActive != 0; }
+};
+
+
+/** @} */
+
+#endif /* BUTTON_REPORT_H_ */
@@ -0,0 +1,96 @@
+/**
+ * @file          ButtonShared.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_SHARED_H_
+#define BUTTON_SHARED_H_
+
+/*
+	Host builds only, with build flag BUTTON_ATOMIC: a button ticked by one thread
+	and read by others.
+*/
+
+#ifndef BUTTON_ATOMIC
+ #error "ButtonShared.h needs build flag BUTTON_ATOMIC"
+#endif
+
+#include "Button.h"
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief A button whose state can be read as a consistent snapshot by other threads.
+ *
+ * The individual fields are `SharedVar`s, so reading one of them is always safe,
+ * but several fields read one after the other may come from different ticks.
+ * `read()` returns all fields from the same tick, using a sequence lock: the tick
+ * thread makes the sequence number odd while it updates the fields, readers retry
+ * if it was odd or has changed while they read. The tick thread never waits, and
+ * costs two stores and a fence per tick.
+ *
+ * Only the tick thread may call `tick()`, `idle()`, `skipMillis()` and `clearCounters()`.
+ */
+class SharedButton : public ButtonCore {
+	private:
+		std::atomic<uint32_t>	mSeq;
+
+		void beginWrite() {
+			mSeq.store( mSeq.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+			std::atomic_thread_fence( std::memory_order_release );
+		}
+		void endWrite() {
+			mSeq.store( mSeq.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+		}
+
+	public:
+		SharedButton() : mSeq(0) {}
+
+		void tick( uint8_t isPressed ) { beginWrite(); tickInline( isPressed ); endWrite(); }
+		void idle( uint16_t ticks ) { beginWrite(); ButtonCore::idle( ticks ); endWrite(); }
+		void skipMillis( uint32_t ms ) { beginWrite(); ButtonCore::skipMillis( ms ); endWrite(); }
+
+		/// @brief Reset all counters, as one update.
+		void clearCounters() {
+			beginWrite();
+			cPressed = cReleased = 0;
+			cShortPress = cLongPress = cDoublePress = 0;
+			endWrite();
+		}
+
+		/**
+		 * @brief Get all fields from the same tick, can be called from any thread.
+		 * @param snap	receives state, same format as `save()`
+		 */
+		void read( ButtonSnapshot& snap ) const {
+			uint32_t s1, s2;
+			do {
+				s1 = mSeq.load( std::memory_order_acquire );
+				save( snap );
+				std::atomic_thread_fence( std::memory_order_acquire );
+				s2 = mSeq.load( std::memory_order_relaxed );
+			} while ((s1 & 1) || (s1 != s2));
+		}
+};
+
+
+/** @} */
+
+#endif /* BUTTON_SHARED_H_ */
@@ -0,0 +1,24 @@
+/**
+ * @file 		  ButtonTrace.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#include "ButtonTrace.h"
+
+#ifdef BUTTON_TRACE_RING
+/// the trace buffer, all buttons report here
+ButtonTraceRing buttonTraceRing;
+#endif
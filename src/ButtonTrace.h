@@ -0,0 +1,142 @@
+/**
+ * @file          ButtonTrace.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_TRACE_H_
+#define BUTTON_TRACE_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+
+/*
+	Tracing hooks, called at each event site. Select a backend by build flag,
+	the same for all translation units:
+	BUTTON_TRACE_GPIO		toggle a debug pin, for a logic analyzer or simulator VCD trace
+							BUTTON_TRACE_GPIO_PIN	PINx register, e.g. PINB (writing 1 toggles)
+							BUTTON_TRACE_GPIO_BIT	bit number
+							BUTTON_TRACE_GPIO_EVENTS bitmask of events to trace, default all
+	BUTTON_TRACE_RING		record events in ring buffer `buttonTraceRing`
+							BUTTON_TRACE_RING_SIZE	# of entries, power of 2, default 16
+							BUTTON_TRACE_CLOCK		timestamp expression, default TCNT1 on AVR
+	BUTTON_TRACE(ev,obj)	define your own
+	(default)				no-op, no code generated
+*/
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+#if defined(BUTTON_EVENTS) && (defined(BUTTON_TRACE_GPIO) || defined(BUTTON_TRACE_RING) || defined(BUTTON_TRACE))
+ #error "BUTTON_EVENTS uses the BUTTON_TRACE hook, it can't be combined with a trace backend"
+#endif
+
+/// events reported to `BUTTON_TRACE(ev,obj)`
+enum ButtonTraceEvent {
+	TRACE_PRESS = 0,	///< debounced press edge
+	TRACE_RELEASE,		///< debounced release edge
+	TRACE_PENDING,		///< release of a short press, waiting to see if it becomes a double press
+	TRACE_SHORT,		///< short press detected
+	TRACE_LONG,			///< long press detected
+	TRACE_DOUBLE		///< double press detected
+};
+
+
+#if defined(BUTTON_TRACE_GPIO)
+
+ #include <avr/io.h>
+ #ifndef BUTTON_TRACE_GPIO_EVENTS
+  #define BUTTON_TRACE_GPIO_EVENTS 0xFF
+ #endif
+ #define BUTTON_TRACE(ev,obj) \
+	do { if (BUTTON_TRACE_GPIO_EVENTS & (1 << (ev))) BUTTON_TRACE_GPIO_PIN = _BV(BUTTON_TRACE_GPIO_BIT); } while (0)
+
+#elif defined(BUTTON_TRACE_RING)
+
+ #ifndef BUTTON_TRACE_RING_SIZE
+  #define BUTTON_TRACE_RING_SIZE 16
+ #endif
+ #ifndef BUTTON_TRACE_CLOCK
+  #ifdef __AVR__
+   #include <avr/io.h>
+   #define BUTTON_TRACE_CLOCK TCNT1
+  #else
+   #define BUTTON_TRACE_CLOCK 0
+  #endif
+ #endif
+
+/// @brief One recorded event
+struct ButtonTraceEntry {
+	uint16_t			time;		///< value of BUTTON_TRACE_CLOCK
+	uint8_t				event;		///< a `ButtonTraceEvent`
+	const void*			obj;		///< `Contact` part of the object that reported the event
+};
+
+
+/**
+ * @brief Ring buffer of trace events, written from the ISR, read from the main loop.
+ * When full, new events are dropped and counted.
+ */
+class ButtonTraceRing {
+	private:
+		ButtonTraceEntry	mBuf[BUTTON_TRACE_RING_SIZE];
+		volatile uint8_t	mHead;
+		volatile uint8_t	mTail;
+
+	public:
+		volatile uint8_t	cDropped;	///< count # of events lost because buffer was full
+
+		void put( uint8_t event, const void* obj ) {
+			uint8_t h = mHead;
+			if ((uint8_t)(h - mTail) >= BUTTON_TRACE_RING_SIZE) {
+				if (cDropped < UINT8_MAX) cDropped++;
+				return;
+			}
+			ButtonTraceEntry& e = mBuf[h & (BUTTON_TRACE_RING_SIZE-1)];
+			e.time = BUTTON_TRACE_CLOCK;
+			e.event = event;
+			e.obj = obj;
+			mHead = h+1;
+		}
+
+		bool get( ButtonTraceEntry& e ) {
+			uint8_t t = mTail;
+			if (t == mHead) return false;
+			e = mBuf[t & (BUTTON_TRACE_RING_SIZE-1)];
+			mTail = t+1;
+			return true;
+		}
+};
+
+extern ButtonTraceRing buttonTraceRing;
+
+ #define BUTTON_TRACE(ev,obj) buttonTraceRing.put( (ev), (obj) )
+
+#elif defined(BUTTON_EVENTS)
+
+ // ButtonEvents.h is included by Button.h
+ #define BUTTON_TRACE(ev,obj) buttonEvents.post( (ev), ((const Contact*)(obj))->eventSource() )
+
+#elif !defined(BUTTON_TRACE)
+
+ #define BUTTON_TRACE(ev,obj) do {} while (0)
+
+#endif
+
+/** @} */
+
+#endif /* BUTTON_TRACE_H_ */
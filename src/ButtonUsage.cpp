@@ -0,0 +1,78 @@
+/**
+ * @file 		  ButtonUsage.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Press duration and interval histograms, read and reset outside the tick ISR.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#ifdef __AVR__
+ #include <util/atomic.h>
+#else
+ // no tick ISR to block: call tick() and read() from the same thread
+ #define ATOMIC_BLOCK(type)
+#endif
+
+#include "ButtonUsage.h"
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief Empty both histograms and forget the previous press.
+void ButtonUsage::clear()
+{
+	memset( mDuration, 0, sizeof(mDuration) );
+	memset( mInterval, 0, sizeof(mInterval) );
+	mLastPress = 0;
+	mHavePress = false;
+}
+
+
+/**
+ * @brief Copy histograms and gesture counters of a button, all from the same tick.
+ * Interrupts are disabled while copying, for about 50 cycles plus 8 per bin.
+ *
+ * @param snap		receives the histograms and counters
+ * @param button	the button whose `tick()` feeds this object
+ * @param reset		if true, clear histograms and gesture counters in the same step,
+ *					so no press is counted twice or lost between two reads
+ */
+void ButtonUsage::read( ButtonUsageSnapshot& snap, ButtonCore& button, bool reset )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		memcpy( snap.duration, mDuration, sizeof(mDuration) );
+		memcpy( snap.interval, mInterval, sizeof(mInterval) );
+		snap.cShortPress = button.cShortPress;
+		snap.cLongPress = button.cLongPress;
+		snap.cDoublePress = button.cDoublePress;
+		if (reset) {
+			memset( mDuration, 0, sizeof(mDuration) );
+			memset( mInterval, 0, sizeof(mInterval) );
+			button.cShortPress = button.cLongPress = button.cDoublePress = 0;
+		}
+	}
+}
+
+
+/** @} */
@@ -0,0 +1,128 @@
+/**
+ * @file          ButtonUsage.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_USAGE_H_
+#define BUTTON_USAGE_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_HIST_BINS		# of histogram bins, default 10
+	BUTTON_HIST_SHIFT		bin 0 holds durations below 2^SHIFT ms, default 6 i.e. 64 ms
+*/
+#ifndef BUTTON_HIST_BINS
+ #define BUTTON_HIST_BINS 10
+#endif
+#ifndef BUTTON_HIST_SHIFT
+ #define BUTTON_HIST_SHIFT 6
+#endif
+// the start of the last bin, 2^(SHIFT+BINS-2) ms, must fit in 16 bits
+#if BUTTON_HIST_BINS < 2 || BUTTON_HIST_SHIFT + BUTTON_HIST_BINS > 17
+ #error "BUTTON_HIST_BINS must be at least 2, and BUTTON_HIST_SHIFT + BUTTON_HIST_BINS at most 17"
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Copy of the histograms and gesture counters of one button, see `ButtonUsage::read()`.
+ * Bin 0 counts durations below 2^BUTTON_HIST_SHIFT ms, bin i those from 2^(SHIFT+i-1) ms
+ * to twice that, the last bin everything above.
+ */
+struct ButtonUsageSnapshot {
+	uint16_t	duration[BUTTON_HIST_BINS];	///< press durations, from press to release
+	uint16_t	interval[BUTTON_HIST_BINS];	///< intervals from one press to the next
+	uint8_t		cShortPress;
+	uint8_t		cLongPress;
+	uint8_t		cDoublePress;
+};
+
+
+/**
+ * @brief Press duration and inter-press interval histograms for one button, for usage analytics.
+ *
+ * Bins are logarithmic, so a few bins cover everything from a tap to a press of a minute.
+ * Only edges cost time: `tick()` returns at once unless the button just changed, a
+ * release adds `holdTime` to the duration histogram, a press adds the time since the
+ * previous press to the interval histogram. That time comes from a timestamp supplied
+ * by the caller, e.g. a millisecond counter the application keeps anyway, so nothing
+ * is counted per tick. Counts saturate at UINT16_MAX.
+ */
+class ButtonUsage {
+	private:
+		uint16_t			mDuration[BUTTON_HIST_BINS];
+		uint16_t			mInterval[BUTTON_HIST_BINS];
+		uint32_t			mLastPress;		// timestamp of previous press
+		bool				mHavePress;		// mLastPress is valid
+
+		static BUTTON_ALWAYS_INLINE void add( uint16_t* hist, uint16_t ms );
+
+	public:
+		ButtonUsage() { clear(); }
+		void clear();
+
+		/// bin for a duration of `ms`
+		static uint8_t bin( uint16_t ms ) {
+			uint8_t b = 0;
+			for (ms >>= BUTTON_HIST_SHIFT; ms && b < BUTTON_HIST_BINS-1; ms >>= 1) b++;
+			return b;
+		}
+		/// lower limit of bin `b` in ms
+		static uint16_t binStart( uint8_t b ) { return b ? (uint16_t)(1u << (BUTTON_HIST_SHIFT + b - 1)) : 0; }
+
+		BUTTON_ALWAYS_INLINE void tick( uint8_t edge, const ButtonCore& button, uint32_t nowMs );
+
+		void read( ButtonUsageSnapshot& snap, ButtonCore& button, bool reset );
+};
+
+
+BUTTON_ALWAYS_INLINE void ButtonUsage::add( uint16_t* hist, uint16_t ms )
+{
+	uint16_t* p = &hist[ bin( ms ) ];
+	if (*p < UINT16_MAX) (*p)++;
+}
+
+
+/**
+ * @brief Update the histograms, call after each tick of the button.
+ * @param edge		result of `button.tickInline()`
+ * @param button	the button, for `holdTime`
+ * @param nowMs		current time in ms, only used at a press
+ */
+BUTTON_ALWAYS_INLINE void ButtonUsage::tick( uint8_t edge, const ButtonCore& button, uint32_t nowMs )
+{
+	if (edge == Debounce::RELEASE) {
+		add( mDuration, button.holdTime );
+	} else if (edge == Debounce::PRESS) {
+		if (mHavePress) {
+			uint32_t dt = nowMs - mLastPress;
+			add( mInterval, (dt > UINT16_MAX) ? UINT16_MAX : (uint16_t)dt );
+		}
+		mLastPress = nowMs;
+		mHavePress = true;
+	}
+}
+
+
+/** @} */
+
+#endif /* BUTTON_USAGE_H_ */
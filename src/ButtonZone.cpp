@@ -0,0 +1,102 @@
+/**
+ * @file 		  ButtonZone.cpp
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+/**
+ * @brief Supervised alarm zones with end-of-line resistors, one ADC scanned round-robin.
+ *
+ * e.g. 4k7 EOL and 4k7 alarm resistor, 4k7 pull-up to AVcc, 10-bit ADC:
+ * short reads 0, normal 512, alarm 682, cut 1023:
+ *
+ *		ZoneInput zones[6];
+ *		ZoneScanner scanner( zones, 6 );
+ *
+ *		for (uint8_t i=0; i<6; i++) zones[i].init( i );
+ *		scanner.begin( _BV(REFS0), _BV(ADPS2) | _BV(ADPS1), ZoneThresholds{ 256, 597, 852 } );
+ *		// then call scanner.tick() from the tick ISR
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#ifdef __AVR__
+ #include <avr/io.h>
+#endif
+
+#include "ButtonZone.h"
+
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/**
+ * @brief Set the zones to scan, each must be initialized with its channel.
+ *
+ * @param zones		array of zones
+ * @param count		# of zones
+ */
+void ZoneScanner::init( ZoneInput* zones, uint8_t count )
+{
+	mZones = zones;
+	mCount = count;
+	mCurrent = 0;
+	mBusy = false;
+	select = 0;
+	alarmMask = tamperMask = 0;
+}
+
+
+#ifdef __AVR__
+/**
+ * @brief Enable the ADC.
+ *
+ * @param refs			reference selection bits for ADMUX, e.g. `_BV(REFS0)` for AVcc
+ * @param prescaler		ADC clock prescaler bits for ADCSRA, ADC clock should be 50-200 kHz
+ * @param t				limits between zone states
+ */
+void ZoneScanner::begin( uint8_t refs, uint8_t prescaler, const ZoneThresholds& t )
+{
+	mRefs = refs;
+	limits = t;
+	mCurrent = 0;
+	mBusy = false;
+	ADCSRA = _BV(ADEN) | (prescaler & 7);
+}
+
+
+/**
+ * @brief Read the previous conversion, start the next one, call from the tick ISR.
+ */
+void ZoneScanner::tick()
+{
+	if (!mCount) return;
+	uint8_t ch = channel();
+	if (mBusy) {
+		if (ADCSRA & _BV(ADSC)) return;
+		ch = next( ADC );
+	}
+	if (select) select( ch >> 4 );
+	ADMUX = mRefs | (ch & 0x0F);
+	ADCSRA |= _BV(ADSC);
+	mBusy = true;
+}
+#endif
+
+
+/** @} */
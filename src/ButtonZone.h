@@ -0,0 +1,192 @@
+/**
+ * @file          ButtonZone.h
+ * @author		  Bernd Waldmann
+ * Created		: 17-Oct-2026
+ * Tabsize		: 4
+ *
+ * This Revision: $Id$
+ */
+
+/*
+   Copyright (C) 2026 Bernd Waldmann
+
+   This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+   If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/
+
+   SPDX-License-Identifier: MPL-2.0
+*/
+
+#ifndef BUTTON_ZONE_H_
+#define BUTTON_ZONE_H_
+
+#include "Button.h"
+
+/*
+	Build flags:
+	BUTTON_ZONE_SAMPLES		a new zone state must be read this many times in a row, default BUTTON_NTICKS
+*/
+#ifndef BUTTON_ZONE_SAMPLES
+ #define BUTTON_ZONE_SAMPLES BUTTON_NTICKS
+#endif
+
+/**
+ * @ingroup Button
+ * @{
+ */
+
+
+/// @brief State of a supervised alarm zone
+enum ZoneState {
+	ZONE_NORMAL = 0,		///< loop closed through the EOL resistor
+	ZONE_ALARM = 1,			///< contact open, loop through EOL plus alarm resistor
+	ZONE_CUT = 2,			///< loop open, wire cut (tamper)
+	ZONE_SHORT = 3			///< loop shorted (tamper)
+};
+
+
+/**
+ * @brief ADC limits between the zone states, same for all zones of an installation.
+ * With the EOL resistor at the far end and the alarm resistor in series with it,
+ * the reading rises from short over normal and alarm to cut.
+ */
+struct ZoneThresholds {
+	uint16_t	shortMax;		///< at or below: ZONE_SHORT
+	uint16_t	normalMax;		///< at or below: ZONE_NORMAL
+	uint16_t	alarmMax;		///< at or below: ZONE_ALARM, above: ZONE_CUT
+
+	/// @brief State for one ADC reading
+	uint8_t classify( uint16_t v ) const {
+		if (v <= shortMax) return ZONE_SHORT;
+		if (v <= normalMax) return ZONE_NORMAL;
+		if (v <= alarmMax) return ZONE_ALARM;
+		return ZONE_CUT;
+	}
+};
+
+
+/**
+ * @brief One supervised alarm zone, i.e. one loop with EOL resistor.
+ * A new state is accepted once it was read BUTTON_ZONE_SAMPLES times in a row,
+ * the same rule as for buttons, but with four states instead of two.
+ */
+class ZoneInput {
+	private:
+		uint8_t				mCandidate;		// state seen in the most recent readings
+		uint8_t				mCount;			// # of readings in a row of mCandidate
+
+	public:
+		uint8_t				channel;		///< bits 0..3: ADC mux channel, bits 4..7: external multiplexer
+		BUTTON_SHARED(uint8_t)	state;			///< debounced `ZoneState`
+		BUTTON_SHARED(uint8_t)	cAlarm;			///< count # of changes to ZONE_ALARM, can be reset by application
+		BUTTON_SHARED(uint8_t)	cTamper;		///< count # of changes to ZONE_CUT or ZONE_SHORT, can be reset by application
+
+		void init( uint8_t ch ) {
+			channel = ch;
+			state = ZONE_NORMAL;
+			mCandidate = ZONE_NORMAL;
+			mCount = 0;
+			cAlarm = cTamper = 0;
+		}
+
+		BUTTON_ALWAYS_INLINE bool sample( uint8_t s );
+};
+
+
+/**
+ * @brief Debounce one classified reading.
+ * @param s		`ZoneState` of the reading
+ * @return true if the debounced state changed
+ */
+BUTTON_ALWAYS_INLINE bool ZoneInput::sample( uint8_t s )
+{
+	if (s == state) {
+		mCount = 0;
+		return false;
+	}
+	if (s != mCandidate) {
+		mCandidate = s;
+		mCount = 0;
+	}
+	if (++mCount < BUTTON_ZONE_SAMPLES) return false;
+
+	mCount = 0;
+	state = s;
+	if (s == ZONE_ALARM) {
+		if (cAlarm < UINT8_MAX) cAlarm++;
+	} else if (s != ZONE_NORMAL) {
+		if (cTamper < UINT8_MAX) cTamper++;
+	}
+	return true;
+}
+
+
+/**
+ * @brief Scan many zones with one ADC, one conversion per tick.
+ *
+ * Works like `AnalogScanner`: each `tick()` reads the conversion started by the
+ * previous one and starts the next, so the ISR time per tick is one classification
+ * and one debounce step, for any # of zones. With N zones, each is read every N ticks,
+ * e.g. 32 zones at 1 ms per tick and 3 samples take about 100 ms to report a change.
+ *
+ * More zones than ADC inputs can be connected through external analog multiplexers:
+ * `select` is called with the upper 4 bits of the zone's channel before its conversion
+ * is started.
+ *
+ * Only `begin()` and `tick()` access the ADC registers. Classification and debouncing
+ * are portable, readings can also be fed with `next()`.
+ */
+class ZoneScanner {
+	private:
+		ZoneInput*			mZones;
+		uint8_t				mCount;
+		uint8_t				mCurrent;		// zone whose conversion is running
+		uint8_t				mRefs;			// reference selection bits for ADMUX
+		bool				mBusy;			// a conversion was started
+
+	public:
+		ZoneThresholds		limits;
+		void				(*select)( uint8_t ext );	///< optional, switch external multiplexer
+		BUTTON_SHARED(ButtonMask)	alarmMask;		///< bit i set while zone i is in ZONE_ALARM, for `AlarmZones::tick()`
+		BUTTON_SHARED(ButtonMask)	tamperMask;		///< bit i set while zone i is cut or shorted, for `AlarmZones::tick()`
+
+		ZoneScanner( ZoneInput* zones, uint8_t count ) { init( zones, count ); }
+		void init( ZoneInput* zones, uint8_t count );
+#ifdef __AVR__
+		void begin( uint8_t refs, uint8_t prescaler, const ZoneThresholds& t );
+		void tick();
+#endif
+
+		/// channel of the zone whose reading `next()` takes
+		uint8_t channel() const { return mZones[mCurrent].channel; }
+		BUTTON_ALWAYS_INLINE uint8_t next( uint16_t v );
+
+		/// access zone `i` (0-based)
+		ZoneInput& operator[]( uint8_t i ) { return mZones[i]; }
+		uint8_t count() const { return mCount; }
+};
+
+
+/**
+ * @brief Classify and debounce the reading of the current zone, go on to the next one.
+ * Call only if there is at least one zone, and with `limits` set.
+ *
+ * @param v		ADC reading of `channel()`
+ * @return	channel to convert next
+ */
+BUTTON_ALWAYS_INLINE uint8_t ZoneScanner::next( uint16_t v )
+{
+	ZoneInput& z = mZones[mCurrent];
+	if (z.sample( limits.classify( v ) ) && mCurrent < BUTTON_GROUP_SIZE) {
+		// only the first BUTTON_GROUP_SIZE zones have a bit in the masks
+		ButtonMask bit = (ButtonMask)1 << mCurrent;
+		if (z.state == ZONE_ALARM) alarmMask |= bit; else alarmMask &= (ButtonMask)~bit;
+		if (z.state >= ZONE_CUT) tamperMask |= bit; else tamperMask &= (ButtonMask)~bit;
+	}
+	if (++mCurrent >= mCount) mCurrent = 0;
+	return mZones[mCurrent].channel;
+}
+
+
+/** @} */
+
+#endif /* BUTTON_ZONE_H_ */